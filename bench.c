@@ -0,0 +1,572 @@
+#include <stdio.h>
+#include <getopt.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <time.h>
+#include <string.h>
+#include "csp.h"
+
+#define BENCH_LIST 32 // Most values one swept parameter can take
+
+// One point of the sweep
+typedef struct
+{
+    const Strategy *strategy;
+    int days;
+    int maxChanges;
+    int tabuSize;
+    int tabuTenure;
+    double p;
+    double temperature;
+    double coolingRate;
+    int cooling;
+    int init;
+} BenchConfig;
+
+// Statistics of all the seeds of one point
+typedef struct
+{
+    int runs;
+    int solved;
+    double wallTotal;
+    double movesPerSecond;
+    double wallMedian, wallP95, wallP99;
+    double solveMedian, solveP95, solveP99; // Time to solution, over the runs that found one
+    double firstSolution;                   // Wall time from the start of the point to its first solution, -1 if none
+    double bestCostMean;
+    double bestPenaltyMean;
+} BenchStats;
+
+// Functions signature
+int parseIntList(const char *text, const char *name, int minimum, int *list);
+int parseDoubleList(const char *text, const char *name, double *list);
+int parseInitList(const char *text, int *list);
+int compareDouble(const void *a, const void *b);
+double percentile(const double *sorted, int count, double fraction);
+int benchPoint(const BenchConfig *config, const ConstraintGraph *graph, int numberofvariables, int maxTries, uint64_t seed, int seeds, BenchStats *stats);
+void writeCsvField(FILE *file, const char *text);
+void writeJsonString(FILE *file, const char *text);
+void writeBenchCsv(FILE *file, const char *label, const BenchConfig *config, int maxTries, const BenchStats *stats, int header);
+void writeBenchJson(FILE *file, const char *label, const BenchConfig *config, int maxTries, const BenchStats *stats, int first);
+void printBenchUsage(const char *program);
+
+// mc bench...runs every combination of the swept parameters over the same seeds
+int benchMain(int argc, char *argv[])
+{
+    const Strategy *strategies[BENCH_LIST] = {&minConflictsStrategy};
+    int daysList[BENCH_LIST] = {25}, changesList[BENCH_LIST] = {1000}, tabuList[BENCH_LIST] = {TABU_SIZE};
+    double pList[BENCH_LIST] = {WALK_PROBABILITY};
+    int strategyCount = 1, daysCount = 1, changesCount = 1, tabuCount = 1, pCount = 1;
+    int maxTries = 10, seeds = 20, json = -1, tabuTenure = TENURE_FIXED, cooling = COOLING_GEOMETRIC;
+    double temperature = ANNEAL_TEMPERATURE, coolingRate = ANNEAL_COOLING;
+    int initList[BENCH_LIST] = {INIT_RANDOM}, initCount = 1;
+    uint64_t seed = 1;
+    const char *inputName = "BetterCSVview.csv";
+    const char *outputName = NULL; // stdout
+    const char *label = "";
+    const char *softKinds = SOFT_KINDS;
+    const char *sizesName = NULL; // No exam sizes
+    const char *capacity = NULL;  // No slot capacities
+
+    static const struct option options[] = {
+        {"strategy", required_argument, NULL, 'S'},
+        {"days", required_argument, NULL, 'd'},
+        {"changes", required_argument, NULL, 'c'},
+        {"tabu-size", required_argument, NULL, 'T'},
+        {"tabu-tenure", required_argument, NULL, 'R'},
+        {"walk-probability", required_argument, NULL, 'p'},
+        {"temperature", required_argument, NULL, 'K'},
+        {"cooling-rate", required_argument, NULL, 'a'},
+        {"cooling", required_argument, NULL, 'm'},
+        {"init", required_argument, NULL, 'g'},
+        {"tries", required_argument, NULL, 't'},
+        {"seeds", required_argument, NULL, 'n'},
+        {"seed", required_argument, NULL, 's'},
+        {"input", required_argument, NULL, 'i'},
+        {"output", required_argument, NULL, 'o'},
+        {"format", required_argument, NULL, 'F'},
+        {"label", required_argument, NULL, 'l'},
+        {"soft", required_argument, NULL, 'k'},
+        {"sizes", required_argument, NULL, 'z'},
+        {"capacity", required_argument, NULL, 'C'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}};
+
+    int option;
+    optind = 1;
+    while ((option = getopt_long(argc, argv, "S:d:c:T:R:p:K:a:m:g:t:n:s:i:o:F:l:k:z:C:h", options, NULL)) != -1)
+    {
+        switch (option)
+        {
+        case 'S':
+            strategyCount = parseStrategyList(optarg, "strategy", strategies, BENCH_LIST);
+            break;
+        case 'd':
+            daysCount = parseIntList(optarg, "days", 1, daysList);
+            break;
+        case 'c':
+            changesCount = parseIntList(optarg, "changes", 1, changesList);
+            break;
+        case 'T':
+            tabuCount = parseIntList(optarg, "tabu-size", 1, tabuList);
+            break;
+        case 'R':
+            tabuTenure = findTenure(optarg);
+            if (tabuTenure < 0)
+            {
+                fprintf(stderr, "Invalid value for --tabu-tenure: %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 'p':
+            pCount = parseDoubleList(optarg, "walk-probability", pList);
+            break;
+        case 'g':
+            initCount = parseInitList(optarg, initList);
+            break;
+        case 'K':
+            temperature = parseDouble(optarg, "temperature", 0.0, 1e9);
+            break;
+        case 'a':
+            coolingRate = parseDouble(optarg, "cooling-rate", 0.0, 1.0);
+            break;
+        case 'm':
+            cooling = findCooling(optarg);
+            if (cooling < 0)
+            {
+                fprintf(stderr, "Invalid value for --cooling: %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 't':
+            maxTries = parseInt(optarg, "tries", 1);
+            break;
+        case 'n':
+            seeds = parseInt(optarg, "seeds", 1);
+            break;
+        case 's':
+        {
+            char *end;
+            seed = strtoull(optarg, &end, 10);
+            if (*optarg == '\0' || *end != '\0')
+            {
+                fprintf(stderr, "Invalid value for --seed: %s\n", optarg);
+                return 1;
+            }
+            break;
+        }
+        case 'i':
+            inputName = optarg;
+            break;
+        case 'o':
+            outputName = optarg;
+            break;
+        case 'F':
+            if (strcmp(optarg, "csv") == 0)
+                json = 0;
+            else if (strcmp(optarg, "json") == 0)
+                json = 1;
+            else
+            {
+                fprintf(stderr, "Invalid value for --format: %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 'l':
+            label = optarg;
+            break;
+        case 'k':
+        {
+            ConstraintGraph check; // Only its soft[] is set
+            if (!setSoftKinds(&check, optarg))
+            {
+                fprintf(stderr, "Invalid value for --soft: %s\n", optarg);
+                return 1;
+            }
+            softKinds = optarg;
+            break;
+        }
+        case 'z':
+            sizesName = optarg;
+            break;
+        case 'C':
+            capacity = optarg;
+            break;
+        case 'h':
+            printBenchUsage(argv[0]);
+            return 0;
+        default:
+            printBenchUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (optind < argc)
+    {
+        printBenchUsage(argv[0]);
+        return 1;
+    }
+    if (sizesName != NULL && capacity == NULL)
+    {
+        fprintf(stderr, "--sizes needs --capacity\n");
+        return 1;
+    }
+
+    // The format follows the file name unless --format says otherwise
+    if (json < 0)
+    {
+        const char *dot = (outputName != NULL) ? strrchr(outputName, '.') : NULL;
+        json = (dot != NULL && strcmp(dot, ".json") == 0);
+    }
+
+    FILE *outputFile = stdout;
+    if (outputName != NULL)
+    {
+        outputFile = fopen(outputName, "w");
+        if (outputFile == NULL)
+        {
+            perror(outputName);
+            return 1;
+        }
+    }
+
+    ConstraintGraph graph;
+    int numberofvariables = loadConstraints(inputName, &graph);
+    setSoftKinds(&graph, softKinds);
+    if (sizesName != NULL && !readExamSizes(sizesName, &graph))
+    {
+        fprintf(stderr, "Memory allocation failed.\n");
+        freeConstraintGraph(&graph);
+        return 1;
+    }
+    if (capacity != NULL && !setCapacities(&graph, capacity))
+    {
+        fprintf(stderr, "Invalid value for --capacity: %s\n", capacity);
+        freeConstraintGraph(&graph);
+        return 1;
+    }
+
+    if (json)
+        fprintf(outputFile, "[\n");
+
+    // Parameters a strategy does not use are not swept for it
+    int points = 0;
+    for (int s = 0; s < strategyCount; s++)
+    {
+        int tabuSweep = (strategies[s] == &tabuStrategy) ? tabuCount : 1;
+        int pSweep = (strategies[s] == &walkStrategy) ? pCount : 1;
+        for (int g = 0; g < initCount; g++)
+            for (int d = 0; d < daysCount; d++)
+                for (int c = 0; c < changesCount; c++)
+                    for (int k = 0; k < tabuSweep; k++)
+                        for (int w = 0; w < pSweep; w++)
+                        {
+                            BenchConfig config = {strategies[s], daysList[d], changesList[c], tabuList[k], tabuTenure, pList[w], temperature, coolingRate, cooling, initList[g]};
+                            BenchStats stats;
+                            if (!initSlotTables(&graph, config.days * PERIODS_PER_DAY) ||
+                                !benchPoint(&config, &graph, numberofvariables, maxTries, seed, seeds, &stats))
+                            {
+                                fprintf(stderr, "Memory allocation failed.\n");
+                                freeConstraintGraph(&graph);
+                                return 1;
+                            }
+                            if (json)
+                                writeBenchJson(outputFile, label, &config, maxTries, &stats, points == 0);
+                            else
+                                writeBenchCsv(outputFile, label, &config, maxTries, &stats, points == 0);
+                            fflush(outputFile);
+                            points++;
+                        }
+    }
+
+    if (json)
+        fprintf(outputFile, "\n]\n");
+    if (outputFile != stdout)
+        fclose(outputFile);
+    freeConstraintGraph(&graph);
+    return 0;
+}
+
+// Run one point of the sweep for seeds seed ... seed + seeds - 1, one after the other on this thread
+// Runs are not spread over threads so that they do not compete for cores and caches
+int benchPoint(const BenchConfig *config, const ConstraintGraph *graph, int numberofvariables, int maxTries, uint64_t seed, int seeds, BenchStats *stats)
+{
+    SolverParams params = {maxTries, config->maxChanges, config->p, config->tabuSize, config->tabuTenure, LOG_SUMMARY,
+                           config->temperature, config->coolingRate, config->cooling, config->init, 0.0, -1, NULL, 0, 0};
+    SearchState search;
+    search.graph = graph;
+    search.params = &params;
+    search.numberofvariables = numberofvariables;
+    search.numberofvalues = config->days * PERIODS_PER_DAY;
+    search.elite = NULL;
+    search.bestXvalue = NULL;
+    search.data = NULL;
+    search.Xvalue = malloc(sizeof(int) * numberofvariables);
+    double *wall = malloc(sizeof(double) * seeds);
+    double *solveTime = malloc(sizeof(double) * seeds);
+    if (search.Xvalue == NULL || wall == NULL || solveTime == NULL || (config->strategy->start != NULL && !config->strategy->start(&search)))
+    {
+        free(search.Xvalue);
+        free(wall);
+        free(solveTime);
+        return 0;
+    }
+
+    long long totalMoves = 0;
+    long long totalBestCost = 0;
+    long long totalBestPenalty = 0;
+    stats->runs = seeds;
+    stats->solved = 0;
+    stats->wallTotal = 0.0;
+    stats->firstSolution = -1.0;
+
+    for (int r = 0; r < seeds; r++)
+    {
+        rngSeed(&search.rng, seed + (uint64_t)r);
+        search.moves = 0;
+        search.bestCost = INT_MAX;
+        search.bestPenalty = INT_MAX;
+        search.timedOut = 0;
+
+        double start = wallClock();
+        if (!solve(config->strategy, &search, NULL, NULL, NULL))
+        {
+            if (config->strategy->finish != NULL)
+                config->strategy->finish(&search);
+            free(search.Xvalue);
+            free(wall);
+            free(solveTime);
+            return 0;
+        }
+        wall[r] = wallClock() - start;
+
+        // Time to solution is up to the first assignment without conflicts, not the penalty search after it
+        if (search.bestCost == 0)
+        {
+            solveTime[stats->solved++] = search.solvedAt - start;
+            if (stats->firstSolution < 0.0)
+                stats->firstSolution = stats->wallTotal + (search.solvedAt - start);
+        }
+        stats->wallTotal += wall[r];
+        totalMoves += search.moves;
+        totalBestCost += search.bestCost;
+        totalBestPenalty += search.bestPenalty;
+    }
+    if (config->strategy->finish != NULL)
+        config->strategy->finish(&search);
+
+    qsort(wall, seeds, sizeof(double), compareDouble);
+    qsort(solveTime, stats->solved, sizeof(double), compareDouble);
+    stats->movesPerSecond = (stats->wallTotal > 0.0) ? (double)totalMoves / stats->wallTotal : 0.0;
+    stats->wallMedian = percentile(wall, seeds, 0.50);
+    stats->wallP95 = percentile(wall, seeds, 0.95);
+    stats->wallP99 = percentile(wall, seeds, 0.99);
+    stats->solveMedian = percentile(solveTime, stats->solved, 0.50);
+    stats->solveP95 = percentile(solveTime, stats->solved, 0.95);
+    stats->solveP99 = percentile(solveTime, stats->solved, 0.99);
+    stats->bestCostMean = (double)totalBestCost / seeds;
+    stats->bestPenaltyMean = (double)totalBestPenalty / seeds;
+
+    free(search.Xvalue);
+    free(wall);
+    free(solveTime);
+    return 1;
+}
+
+int compareDouble(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of sorted values...-1 when there are none
+double percentile(const double *sorted, int count, double fraction)
+{
+    if (count == 0)
+        return -1.0;
+    int rank = (int)(fraction * count + 0.999999);
+    if (rank < 1)
+        rank = 1;
+    if (rank > count)
+        rank = count;
+    return sorted[rank - 1];
+}
+
+// Quoted CSV field...a double quote inside is written twice
+void writeCsvField(FILE *file, const char *text)
+{
+    fputc('"', file);
+    for (const char *c = text; *c != '\0'; c++)
+    {
+        if (*c == '"')
+            fputc('"', file);
+        fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+// Quoted JSON string...quotes, backslashes and control characters are escaped
+void writeJsonString(FILE *file, const char *text)
+{
+    fputc('"', file);
+    for (const unsigned char *c = (const unsigned char *)text; *c != '\0'; c++)
+    {
+        if (*c == '"' || *c == '\\')
+            fprintf(file, "\\%c", *c);
+        else if (*c < 0x20)
+            fprintf(file, "\\u%04x", *c);
+        else
+            fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+// Modes are written with the names the options take, not their numbers
+void writeBenchCsv(FILE *file, const char *label, const BenchConfig *config, int maxTries, const BenchStats *stats, int header)
+{
+    if (header)
+        fprintf(file, "label,strategy,days,tries,changes,tabu_size,tabu_tenure,p,temperature,cooling_rate,cooling,init,runs,solved,wall_total,moves_per_sec,wall_median,wall_p95,wall_p99,"
+                      "solve_median,solve_p95,solve_p99,first_solution,best_cost_mean,best_penalty_mean\n");
+    writeCsvField(file, label);
+    fprintf(file, ",%s,%d,%d,%d,%d,%s,%.3f,%g,%g,%s,%s,%d,%d,%.6f,%.0f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.3f,%.3f\n",
+            config->strategy->name, config->days, maxTries, config->maxChanges, config->tabuSize, nameOfTenure(config->tabuTenure), config->p,
+            config->temperature, config->coolingRate, nameOfCooling(config->cooling), nameOfInit(config->init),
+            stats->runs, stats->solved, stats->wallTotal, stats->movesPerSecond, stats->wallMedian, stats->wallP95, stats->wallP99,
+            stats->solveMedian, stats->solveP95, stats->solveP99, stats->firstSolution, stats->bestCostMean, stats->bestPenaltyMean);
+}
+
+void writeBenchJson(FILE *file, const char *label, const BenchConfig *config, int maxTries, const BenchStats *stats, int first)
+{
+    fprintf(file, "%s  {\"label\": ", first ? "" : ",\n");
+    writeJsonString(file, label);
+    fprintf(file, ", \"strategy\": \"%s\", \"days\": %d, \"tries\": %d, \"changes\": %d, \"tabu_size\": %d, \"tabu_tenure\": \"%s\", \"p\": %.3f, ",
+            config->strategy->name, config->days, maxTries, config->maxChanges, config->tabuSize, nameOfTenure(config->tabuTenure), config->p);
+    fprintf(file, "\"temperature\": %g, \"cooling_rate\": %g, \"cooling\": \"%s\", \"init\": \"%s\", ",
+            config->temperature, config->coolingRate, nameOfCooling(config->cooling), nameOfInit(config->init));
+    fprintf(file, "\"runs\": %d, \"solved\": %d, \"wall_total\": %.6f, \"moves_per_sec\": %.0f, \"wall_median\": %.6f, \"wall_p95\": %.6f, \"wall_p99\": %.6f, ",
+            stats->runs, stats->solved, stats->wallTotal, stats->movesPerSecond, stats->wallMedian, stats->wallP95, stats->wallP99);
+    fprintf(file, "\"solve_median\": %.6f, \"solve_p95\": %.6f, \"solve_p99\": %.6f, \"first_solution\": %.6f, \"best_cost_mean\": %.3f, \"best_penalty_mean\": %.3f}",
+            stats->solveMedian, stats->solveP95, stats->solveP99, stats->firstSolution, stats->bestCostMean, stats->bestPenaltyMean);
+}
+
+// Comma separated whole numbers >= minimum
+int parseIntList(const char *text, const char *name, int minimum, int *list)
+{
+    char buffer[256];
+    int count = 0;
+    snprintf(buffer, sizeof(buffer), "%s", text);
+    for (char *item = strtok(buffer, ","); item != NULL; item = strtok(NULL, ","))
+    {
+        if (count == BENCH_LIST)
+        {
+            fprintf(stderr, "Too many values for --%s (at most %d)\n", name, BENCH_LIST);
+            exit(1);
+        }
+        list[count++] = parseInt(item, name, minimum);
+    }
+    if (count == 0)
+    {
+        fprintf(stderr, "Invalid value for --%s: %s\n", name, text);
+        exit(1);
+    }
+    return count;
+}
+
+// Comma separated probabilities
+int parseDoubleList(const char *text, const char *name, double *list)
+{
+    char buffer[256];
+    int count = 0;
+    snprintf(buffer, sizeof(buffer), "%s", text);
+    for (char *item = strtok(buffer, ","); item != NULL; item = strtok(NULL, ","))
+    {
+        char *end;
+        double value = strtod(item, &end);
+        if (*end != '\0' || value < 0.0 || value > 1.0 || count == BENCH_LIST)
+        {
+            fprintf(stderr, "Invalid value for --%s: %s\n", name, text);
+            exit(1);
+        }
+        list[count++] = value;
+    }
+    if (count == 0)
+    {
+        fprintf(stderr, "Invalid value for --%s: %s\n", name, text);
+        exit(1);
+    }
+    return count;
+}
+
+// Comma separated strategy names, at most maximum of them...name is the option, for the error message
+int parseStrategyList(const char *text, const char *name, const Strategy **list, int maximum)
+{
+    char buffer[256];
+    int count = 0;
+    snprintf(buffer, sizeof(buffer), "%s", text);
+    for (char *item = strtok(buffer, ","); item != NULL; item = strtok(NULL, ","))
+    {
+        const Strategy *strategy = findStrategy(item);
+        if (strategy == NULL || count == maximum)
+        {
+            fprintf(stderr, "Invalid value for --%s: %s\n", name, text);
+            exit(1);
+        }
+        list[count++] = strategy;
+    }
+    if (count == 0)
+    {
+        fprintf(stderr, "Invalid value for --%s: %s\n", name, text);
+        exit(1);
+    }
+    return count;
+}
+
+// Comma separated --init names
+int parseInitList(const char *text, int *list)
+{
+    char buffer[256];
+    int count = 0;
+    snprintf(buffer, sizeof(buffer), "%s", text);
+    for (char *item = strtok(buffer, ","); item != NULL; item = strtok(NULL, ","))
+    {
+        int init = findInit(item);
+        if (init < 0 || count == BENCH_LIST)
+        {
+            fprintf(stderr, "Invalid value for --init: %s\n", text);
+            exit(1);
+        }
+        list[count++] = init;
+    }
+    if (count == 0)
+    {
+        fprintf(stderr, "Invalid value for --init: %s\n", text);
+        exit(1);
+    }
+    return count;
+}
+
+void printBenchUsage(const char *program)
+{
+    printf("Usage: %s bench [options]\n", program);
+    printf("Runs every combination of the comma separated values, each over the same seeds.\n");
+    printf("  -S, --strategy LIST         strategies (default minconflicts)\n");
+    printf("  -d, --days LIST             number of days (default 25)\n");
+    printf("  -c, --changes LIST          changes per try (default 1000)\n");
+    printf("  -T, --tabu-size LIST        tabu sizes, tabu only (default %d)\n", TABU_SIZE);
+    printf("  -R, --tabu-tenure MODE      fixed (default), dynamic or reactive, tabu only\n");
+    printf("  -p, --walk-probability LIST random walk probabilities, walk only (default %.1f)\n", WALK_PROBABILITY);
+    printf("  -K, --temperature T         starting temperature, anneal only (default %g)\n", ANNEAL_TEMPERATURE);
+    printf("  -a, --cooling-rate A        temperature factor per move, anneal only (default 0: the one that reaches %g at --changes)\n", ANNEAL_FINAL);
+    printf("  -m, --cooling MODE          geometric (default), adaptive or reheating, anneal only\n");
+    printf("  -g, --init LIST             random (default), dsatur or greedy\n");
+    printf("  -t, --tries N               tries per run (default 10)\n");
+    printf("  -n, --seeds N               runs per combination (default 20)\n");
+    printf("  -s, --seed N                first seed (default 1)\n");
+    printf("  -i, --input FILE            constraints matrix, edge list or binary graph file (default BetterCSVview.csv)\n");
+    printf("  -o, --output FILE           results file (default: standard output)\n");
+    printf("  -F, --format csv|json       default: json if FILE ends in .json, otherwise csv\n");
+    printf("  -l, --label TEXT            copied into every row, e.g. the solver version\n");
+    printf("  -k, --soft KINDS            constraint types that are weighted penalties, e.g. 2,3 or none (default %s)\n", SOFT_KINDS);
+    printf("  -z, --sizes FILE            students of every exam, one exam,size line each (default 1 each, also for unlisted exams)\n");
+    printf("  -C, --capacity LIST         students a slot holds, one value or one per slot, the last one repeats\n");
+}
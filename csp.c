@@ -0,0 +1,1793 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#include "csp.h"
+
+// Weight of neighbour e...1 when weights is NULL, the kind of e is then hard
+static inline int edgeWeight(const int *weights, int e)
+{
+    return (weights != NULL) ? weights[e] : 1;
+}
+
+// The table a kind of constraint goes into, and the weights it is counted with
+static inline int *kindRows(ConflictTable *table, const ConstraintGraph *graph, int kind, const int **weights)
+{
+    *weights = graph->soft[kind] ? graph->weights : NULL;
+    return graph->soft[kind] ? table->penalties : table->conflicts;
+}
+
+// Students over capacity in a slot
+static inline int overflowOf(int occupancy, int capacity)
+{
+    return (occupancy > capacity) ? occupancy - capacity : 0;
+}
+
+// Hard constraints of x
+static inline int hardDegree(const ConstraintGraph *graph, int x)
+{
+    int degree = 0;
+    for (int kind = 1; kind <= EDGE_KINDS; kind++)
+    {
+        if (!graph->soft[kind])
+            degree += graph->segments[x * EDGE_KINDS + kind] - graph->segments[x * EDGE_KINDS + kind - 1];
+    }
+    return degree;
+}
+
+// Seed the generator from one 64-bit number (splitmix64), so nearby seeds give unrelated streams
+void rngSeed(Rng *rng, uint64_t seed)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        rng->s[i] = (uint32_t)((z ^ (z >> 31)) >> 32);
+    }
+    if ((rng->s[0] | rng->s[1] | rng->s[2] | rng->s[3]) == 0)
+    {
+        rng->s[0] = 1;
+    }
+}
+
+// xoshiro128**...next 32 random bits
+uint32_t rngNext(Rng *rng)
+{
+    uint32_t *s = rng->s;
+    uint32_t x = s[1] * 5;
+    uint32_t result = ((x << 7) | (x >> 25)) * 9;
+    uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 11) | (s[3] >> 21);
+    return result;
+}
+
+// Uniform number in [0, range) without the modulo bias of rand() % range (Lemire's method)
+uint32_t rngBounded(Rng *rng, uint32_t range)
+{
+    uint64_t m = (uint64_t)rngNext(rng) * range;
+    uint32_t low = (uint32_t)m;
+    if (low < range)
+    {
+        uint32_t threshold = -range % range;
+        while (low < threshold)
+        {
+            m = (uint64_t)rngNext(rng) * range;
+            low = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
+}
+
+// Log the initial assignment...only when the caller wants the per-move log
+static void logAssignment(const int *Xvalue, int numberofvariables, FILE *outputFile)
+{
+    if (outputFile == NULL)
+    {
+        return;
+    }
+    fprintf(outputFile, "INITIAL ASSIGNMENT:\n");
+    for (int i = 0; i < numberofvariables; i++)
+    {
+        fprintf(outputFile, "X%d = %d\n", i, Xvalue[i]);
+    }
+}
+
+int *initialize(int *Xvalue, int numberofvariables, int numberofvalues, FILE *outputFile, Rng *rng)
+{
+    // A := initial complete assignment of the variables in Problem
+    for (int i = 0; i < numberofvariables; i++)
+    {
+        Xvalue[i] = (int)rngBounded(rng, numberofvalues);
+    }
+    logAssignment(Xvalue, numberofvariables, outputFile);
+    return Xvalue;
+}
+
+// Next variable of DSATUR...the most blocked values first, then the most hard constraints, then at random
+typedef struct
+{
+    int saturation;
+    int degree;
+    uint32_t tie;
+    int x;
+} InitEntry;
+
+static int comesFirst(const InitEntry *a, const InitEntry *b)
+{
+    if (a->saturation != b->saturation)
+        return a->saturation > b->saturation;
+    if (a->degree != b->degree)
+        return a->degree > b->degree;
+    return a->tie > b->tie;
+}
+
+static void pushEntry(InitEntry *heap, int *count, InitEntry entry)
+{
+    int i = (*count)++;
+    while (i > 0 && comesFirst(&entry, &heap[(i - 1) / 2]))
+    {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap[i] = entry;
+}
+
+static InitEntry popEntry(InitEntry *heap, int *count)
+{
+    InitEntry top = heap[0];
+    InitEntry last = heap[--(*count)];
+    int i = 0;
+    while (2 * i + 1 < *count)
+    {
+        int child = 2 * i + 1;
+        if (child + 1 < *count && comesFirst(&heap[child + 1], &heap[child]))
+            child++;
+        if (!comesFirst(&heap[child], &last))
+            break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = last;
+    return top;
+}
+
+// Constructive start...the variables one at a time, each on its value with the fewest conflicts with the variables
+// placed before it (then the lowest penalty, ties at random). The order is DSATUR's when saturation is set,
+// random otherwise (randomized greedy). Rows of the partial assignment are kept with updateConflictTable()
+// Variables with a value in start (NULL for none) keep it and are placed before the others
+// Returns NULL if memory ran out
+int *initializeGreedy(int *Xvalue, int numberofvariables, int numberofvalues, const ConstraintGraph *graph, const int *start, int saturation, FILE *outputFile, Rng *rng)
+{
+    int n = numberofvariables;
+    int edges = graph->offsets[n];
+    ConflictTable partial;
+    memset(&partial, 0, sizeof(partial));
+    partial.conflicts = calloc((size_t)n * numberofvalues + 1, sizeof(int));
+    partial.penalties = calloc((size_t)n * numberofvalues + 1, sizeof(int));
+    int *occupancy = (graph->capacity != NULL) ? calloc(numberofvalues, sizeof(int)) : NULL;
+    unsigned char *placed = calloc(n + 1, 1);
+    int *order = saturation ? NULL : malloc(sizeof(int) * (n + 1));
+    int *blocked = saturation ? calloc(n + 1, sizeof(int)) : NULL;
+    InitEntry *heap = saturation ? malloc(sizeof(InitEntry) * ((size_t)n + edges + 1)) : NULL;
+    int heapCount = 0;
+    if (partial.conflicts == NULL || partial.penalties == NULL || (graph->capacity != NULL && occupancy == NULL) || placed == NULL ||
+        (!saturation && order == NULL) || (saturation && (blocked == NULL || heap == NULL)))
+    {
+        free(partial.conflicts);
+        free(partial.penalties);
+        free(occupancy);
+        free(placed);
+        free(order);
+        free(blocked);
+        free(heap);
+        return NULL;
+    }
+
+    if (saturation)
+    {
+        for (int x = 0; x < n; x++)
+        {
+            InitEntry entry = {0, hardDegree(graph, x), rngNext(rng), x};
+            if (start != NULL && start[x] >= 0)
+            {
+                entry.saturation = blocked[x] = INT_MAX; // Placed first, never updated
+                entry.degree = 0;
+            }
+            pushEntry(heap, &heapCount, entry);
+        }
+    }
+    else
+    {
+        int fixed = 0;
+        for (int x = 0; start != NULL && x < n; x++)
+        {
+            if (start[x] >= 0)
+                order[fixed++] = x;
+        }
+        for (int x = 0, m = fixed; x < n; x++)
+        {
+            if (start != NULL && start[x] >= 0)
+                continue;
+            int k = fixed + (int)rngBounded(rng, m - fixed + 1); // Fisher-Yates after the fixed variables
+            order[m] = order[k];
+            order[k] = x;
+            m++;
+        }
+    }
+
+    for (int step = 0; step < n; step++)
+    {
+        int x;
+        if (saturation)
+        {
+            InitEntry entry;
+            do
+            {
+                entry = popEntry(heap, &heapCount);
+            } while (placed[entry.x] || entry.saturation != blocked[entry.x]); // Stale entries
+            x = entry.x;
+        }
+        else
+        {
+            x = order[step];
+        }
+
+        // Fewest conflicts (students over capacity included), then lowest penalty, ties at random
+        const int *row = partial.conflicts + x * numberofvalues;
+        const int *soft = partial.penalties + x * numberofvalues;
+        int bestValue = 0, bestCost = INT_MAX, bestPenalty = INT_MAX, ties = 0;
+        if (start != NULL && start[x] >= 0)
+            bestValue = start[x];
+        for (int value = 0; value < numberofvalues && !(start != NULL && start[x] >= 0); value++)
+        {
+            int cost = row[value];
+            if (occupancy != NULL)
+                cost += overflowOf(occupancy[value] + graph->sizes[x], graph->capacity[value]) - overflowOf(occupancy[value], graph->capacity[value]);
+            if (cost < bestCost || (cost == bestCost && soft[value] < bestPenalty))
+            {
+                bestValue = value;
+                bestCost = cost;
+                bestPenalty = soft[value];
+                ties = 1;
+            }
+            else if (cost == bestCost && soft[value] == bestPenalty && rngBounded(rng, ++ties) == 0)
+            {
+                bestValue = value;
+            }
+        }
+        Xvalue[x] = bestValue;
+        placed[x] = 1;
+        if (occupancy != NULL)
+            occupancy[bestValue] += graph->sizes[x];
+        updateConflictTable(&partial, x, bestValue, +1, numberofvalues, graph);
+
+        // A type 4 constraint is violated for every value but the ordered ones, see initConflictTable()
+        const int *weights;
+        int *rows = kindRows(&partial, graph, 4, &weights);
+        for (int e = graph->segments[x * EDGE_KINDS + 3]; e < graph->segments[(x + 1) * EDGE_KINDS]; e++)
+        {
+            int y = graph->neighbors[e];
+            if (placed[y])
+                continue;
+            int weight = edgeWeight(weights, e);
+            for (int value = 0; value < numberofvalues; value++)
+            {
+                rows[y * numberofvalues + value] += weight;
+            }
+        }
+
+        // Saturation of the hard neighbours still to be placed
+        if (saturation)
+        {
+            for (int kind = 1; kind <= EDGE_KINDS; kind++)
+            {
+                if (graph->soft[kind])
+                    continue;
+                for (int e = graph->segments[x * EDGE_KINDS + kind - 1]; e < graph->segments[x * EDGE_KINDS + kind]; e++)
+                {
+                    int y = graph->neighbors[e];
+                    if (placed[y] || blocked[y] == INT_MAX)
+                        continue;
+                    const int *neighbourRow = partial.conflicts + y * numberofvalues;
+                    int count = 0;
+                    for (int value = 0; value < numberofvalues; value++)
+                    {
+                        count += neighbourRow[value] > 0;
+                    }
+                    if (count != blocked[y])
+                    {
+                        blocked[y] = count;
+                        InitEntry entry = {count, hardDegree(graph, y), rngNext(rng), y};
+                        pushEntry(heap, &heapCount, entry);
+                    }
+                }
+            }
+        }
+    }
+
+    free(partial.conflicts);
+    free(partial.penalties);
+    free(occupancy);
+    free(placed);
+    free(order);
+    free(blocked);
+    free(heap);
+    logAssignment(Xvalue, numberofvariables, outputFile);
+    return Xvalue;
+}
+
+// Add a constraint to a growing list
+void addConstraint(Constraint **list, int *count, int *capacity, int first, int second, int kind, int weight)
+{
+    if (*count == *capacity)
+    {
+        *capacity = (*capacity == 0) ? 1024 : *capacity * 2;
+        *list = realloc(*list, sizeof(Constraint) * *capacity);
+        if (*list == NULL)
+        {
+            printf("Memory allocation failed.\n");
+            exit(1);
+        }
+    }
+    (*list)[*count].first = first;
+    (*list)[*count].second = second;
+    (*list)[*count].kind = kind;
+    (*list)[*count].weight = weight;
+    (*count)++;
+}
+
+// Read from CSV file
+// The number of variables is the size of the matrix, only the upper triangle holds constraints
+// The file is parsed one character at a time from fixed blocks, so rows can be of any width
+int readConstraintsMatrix(const char *filename, ConstraintGraph *graph)
+{
+    FILE *file = fopen(filename, "r");
+    if (file == NULL)
+    {
+        printf("ERROR OPENING CSV FILE.\n");
+        exit(1);
+    }
+
+    char buffer[65536];
+    size_t length;
+    Constraint *list = NULL;
+    int count = 0, capacity = 0;
+    int row = 0, col = 0, numberofvariables = 0;
+    int constraint = 0, negative = 0, fraction = 0; // The cell being read...empty cells are 0, like atoi()
+    int content = 0;                                 // The line has something other than blanks
+
+    do
+    {
+        length = fread(buffer, 1, sizeof(buffer), file);
+        for (size_t k = 0; k <= length; k++)
+        {
+            // The end of the file ends the last line
+            int c = (k < length) ? (unsigned char)buffer[k] : (length < sizeof(buffer) ? '\n' : -1);
+            if (c == -1)
+                break;
+
+            if (c >= '0' && c <= '9')
+            {
+                if (!fraction && constraint < 1000)
+                    constraint = constraint * 10 + (c - '0');
+                content = 1;
+            }
+            else if (c == ',' || c == '\n')
+            {
+                if (c == ',')
+                    content = 1;
+                if (content && col > row && (constraint != 0 || negative))
+                {
+                    // Only the four documented types are accepted
+                    if (negative || constraint > 4)
+                    {
+                        printf("INVALID CONSTRAINT TYPE IN ROW %d, COLUMN %d OF %s.\n", row + 1, col + 1, filename);
+                        exit(1);
+                    }
+                    addConstraint(&list, &count, &capacity, row, col, constraint, 1);
+                }
+                constraint = negative = fraction = 0;
+                col++;
+
+                if (c == '\n')
+                {
+                    // Skip blank lines (the file ends with one)
+                    if (content)
+                    {
+                        if (col > numberofvariables)
+                            numberofvariables = col;
+                        row++;
+                    }
+                    col = 0;
+                    content = 0;
+                }
+            }
+            else if (c == '-')
+            {
+                negative = 1;
+                content = 1;
+            }
+            else if (c == '.')
+            {
+                fraction = 1; // 1.0 is 1
+                content = 1;
+            }
+            else if (c != ' ' && c != '\r' && c != '\t')
+            {
+                content = 1;
+            }
+        }
+    } while (length == sizeof(buffer));
+    if (row > numberofvariables)
+        numberofvariables = row;
+
+    fclose(file);
+
+    if (!buildConstraintGraph(graph, numberofvariables, list, count))
+    {
+        printf("Memory allocation failed.\n");
+        exit(1);
+    }
+    free(list);
+    return numberofvariables;
+}
+
+// Read from an edge list...one "i,j,kind" or "i,j,kind,weight" constraint per line after the EDGE_LIST_HEADER line, which may end in EDGE_LIST_WEIGHT
+// i and j are 0-based exam numbers, for type 4 Xi comes first. The weight is 1 if it is left out
+// Lines starting with # are comments
+// The number of variables is the highest exam number + 1
+int readConstraintsEdges(const char *filename, ConstraintGraph *graph)
+{
+    FILE *file = fopen(filename, "r");
+    if (file == NULL)
+    {
+        printf("ERROR OPENING EDGE LIST FILE.\n");
+        exit(1);
+    }
+
+    char buffer[65536];
+    size_t length;
+    Constraint *list = NULL;
+    int count = 0, capacity = 0, numberofvariables = 0;
+    int line = 1;
+    long fields[4];
+    int field = 0, digits = 0, content = 0;
+    int skip = 0;   // Rest of the line is a comment
+    int header = 0; // Characters of EDGE_LIST_HEADER EDGE_LIST_WEIGHT matched so far on the first line
+
+    do
+    {
+        length = fread(buffer, 1, sizeof(buffer), file);
+        for (size_t k = 0; k <= length; k++)
+        {
+            // The end of the file ends the last line
+            int c = (k < length) ? (unsigned char)buffer[k] : (length < sizeof(buffer) ? '\n' : -1);
+            if (c == -1)
+                break;
+
+            if (c == '\n')
+            {
+                if (header > 0 && header != (int)strlen(EDGE_LIST_HEADER) && header != (int)(strlen(EDGE_LIST_HEADER) + strlen(EDGE_LIST_WEIGHT)))
+                {
+                    printf("INVALID EDGE LIST LINE %d OF %s: EXPECTED %s OR %s%s.\n", line, filename, EDGE_LIST_HEADER, EDGE_LIST_HEADER, EDGE_LIST_WEIGHT);
+                    exit(1);
+                }
+                if (!skip && (content || digits))
+                {
+                    if (!digits || field < 2)
+                    {
+                        printf("INVALID EDGE LIST LINE %d OF %s: EXPECTED i,j,kind.\n", line, filename);
+                        exit(1);
+                    }
+                    long i = fields[0], j = fields[1], kind = fields[2];
+                    long weight = (field == 3) ? fields[3] : 1;
+                    if (i >= MAX_VARIABLES || j >= MAX_VARIABLES || i == j)
+                    {
+                        printf("INVALID EDGE LIST LINE %d OF %s: BAD EXAM NUMBER.\n", line, filename);
+                        exit(1);
+                    }
+                    if (kind < 1 || kind > 4)
+                    {
+                        printf("INVALID EDGE LIST LINE %d OF %s: CONSTRAINT TYPE %ld IS NOT 1-4.\n", line, filename, kind);
+                        exit(1);
+                    }
+                    if (weight < 1 || weight > MAX_WEIGHT)
+                    {
+                        printf("INVALID EDGE LIST LINE %d OF %s: WEIGHT %ld IS NOT 1-%d.\n", line, filename, weight, MAX_WEIGHT);
+                        exit(1);
+                    }
+                    addConstraint(&list, &count, &capacity, (int)i, (int)j, (int)kind, (int)weight);
+                    if (i >= numberofvariables)
+                        numberofvariables = (int)i + 1;
+                    if (j >= numberofvariables)
+                        numberofvariables = (int)j + 1;
+                }
+                field = digits = content = skip = 0;
+                line++;
+            }
+            else if (skip || c == ' ' || c == '\t' || c == '\r')
+            {
+                continue;
+            }
+            else if (c == '#' && !content && !digits)
+            {
+                skip = 1;
+            }
+            else if (line == 1 && !content && !digits && (header > 0 || c == EDGE_LIST_HEADER[0]))
+            {
+                // The header has to be the whole line, anything else on it is a malformed line
+                if (c != (EDGE_LIST_HEADER EDGE_LIST_WEIGHT)[header])
+                {
+                    printf("INVALID EDGE LIST LINE %d OF %s: EXPECTED %s OR %s%s.\n", line, filename, EDGE_LIST_HEADER, EDGE_LIST_HEADER, EDGE_LIST_WEIGHT);
+                    exit(1);
+                }
+                header++;
+            }
+            else if (c >= '0' && c <= '9')
+            {
+                if (!digits)
+                    fields[field] = 0;
+                if (fields[field] < MAX_VARIABLES)
+                    fields[field] = fields[field] * 10 + (c - '0');
+                digits = 1;
+            }
+            else if (c == ',' && digits && field < 3)
+            {
+                field++;
+                digits = 0;
+                content = 1;
+            }
+            else
+            {
+                // Signs, letters, empty fields and a fifth field all end up here
+                printf("INVALID EDGE LIST LINE %d OF %s: UNEXPECTED '%c'.\n", line, filename, c);
+                exit(1);
+            }
+        }
+    } while (length == sizeof(buffer));
+    fclose(file);
+
+    if (!buildConstraintGraph(graph, numberofvariables, list, count))
+    {
+        printf("Memory allocation failed.\n");
+        exit(1);
+    }
+    free(list);
+    return numberofvariables;
+}
+
+// Read the constraints from a binary graph file, an edge list or a CSV matrix, whichever the file starts like
+int loadConstraints(const char *filename, ConstraintGraph *graph)
+{
+    char start[16];
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL)
+    {
+        printf("ERROR OPENING INPUT FILE %s.\n", filename);
+        exit(1);
+    }
+    size_t length = fread(start, 1, sizeof(start), file);
+    fclose(file);
+
+    if (length >= strlen(GRAPH_MAGIC) && memcmp(start, GRAPH_MAGIC, strlen(GRAPH_MAGIC)) == 0)
+    {
+        return mapConstraintGraph(filename, graph);
+    }
+    if (length >= strlen(GRAPH_MAGIC) && memcmp(start, GRAPH_MAGIC, strlen(GRAPH_MAGIC) - 1) == 0)
+    {
+        printf("%s WAS WRITTEN BY ANOTHER VERSION, CONVERT THE INSTANCE AGAIN.\n", filename);
+        exit(1);
+    }
+    if (length >= strlen(EDGE_LIST_HEADER) && memcmp(start, EDGE_LIST_HEADER, strlen(EDGE_LIST_HEADER)) == 0)
+    {
+        return readConstraintsEdges(filename, graph);
+    }
+    return readConstraintsMatrix(filename, graph);
+}
+
+// Binary graph file...a GraphFileHeader followed by the arrays of the graph as they are in memory:
+// offsets[n + 1], segments[n * EDGE_KINDS + 1], neighbors[edges] and weights[edges] as int32, then kinds[edges] as bytes
+// The numbers are in the byte order of the machine that wrote the file
+int writeConstraintGraph(const char *filename, const ConstraintGraph *graph)
+{
+    int n = graph->numberofvariables;
+    GraphFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GRAPH_MAGIC, sizeof(header.magic));
+    header.numberofvariables = n;
+    header.edges = graph->offsets[n];
+    header.edgeKinds = EDGE_KINDS;
+
+    FILE *file = fopen(filename, "wb");
+    if (file == NULL)
+    {
+        perror(filename);
+        return 0;
+    }
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(graph->offsets, sizeof(int), n + 1, file) == (size_t)n + 1 &&
+             fwrite(graph->segments, sizeof(int), (size_t)n * EDGE_KINDS + 1, file) == (size_t)n * EDGE_KINDS + 1 &&
+             fwrite(graph->neighbors, sizeof(int), header.edges, file) == (size_t)header.edges &&
+             fwrite(graph->weights, sizeof(int), header.edges, file) == (size_t)header.edges &&
+             fwrite(graph->kinds, 1, header.edges, file) == (size_t)header.edges;
+    if (fclose(file) != 0 || !ok)
+    {
+        perror(filename);
+        return 0;
+    }
+    return 1;
+}
+
+// Write the timetable of an assignment...one exam,day,period row per exam, or JSON if filename ends in .json
+// Needs the slot tables of initSlotTables()
+int writeSchedule(const char *filename, const int *Xvalue, const ConstraintGraph *graph, int collisions, int penalty)
+{
+    const char *dot = strrchr(filename, '.');
+    int json = (dot != NULL && strcmp(dot, ".json") == 0);
+    FILE *file = fopen(filename, "w");
+    if (file == NULL)
+    {
+        perror(filename);
+        return 0;
+    }
+    if (json)
+    {
+        fprintf(file, "{\"collisions\": %d, \"penalty\": %d, \"days\": %d, \"periods_per_day\": %d, \"schedule\": [\n",
+                collisions, penalty, graph->numberofvalues / PERIODS_PER_DAY, PERIODS_PER_DAY);
+        for (int x = 0; x < graph->numberofvariables; x++)
+        {
+            fprintf(file, "  {\"exam\": %d, \"day\": %d, \"period\": %d}%s\n", x, graph->day[Xvalue[x]], graph->period[Xvalue[x]],
+                    (x + 1 < graph->numberofvariables) ? "," : "");
+        }
+        fprintf(file, "]}\n");
+    }
+    else
+    {
+        fprintf(file, "exam,day,period\n");
+        for (int x = 0; x < graph->numberofvariables; x++)
+        {
+            fprintf(file, "%d,%d,%d\n", x, graph->day[Xvalue[x]], graph->period[Xvalue[x]]);
+        }
+    }
+    int ok = !ferror(file);
+    if (fclose(file) != 0 || !ok)
+    {
+        perror(filename);
+        return 0;
+    }
+    return 1;
+}
+
+// Map a binary graph file...the graph points straight into the mapping, nothing is copied, only checked once
+int mapConstraintGraph(const char *filename, ConstraintGraph *graph)
+{
+    int fd = open(filename, O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0)
+    {
+        printf("ERROR OPENING GRAPH FILE.\n");
+        exit(1);
+    }
+    size_t size = (size_t)info.st_size;
+    void *mapping = (size >= sizeof(GraphFileHeader)) ? mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        printf("INVALID GRAPH FILE.\n");
+        exit(1);
+    }
+
+    // Check that the arrays the header announces are all in the file
+    const GraphFileHeader *header = mapping;
+    size_t n = header->numberofvariables >= 0 ? (size_t)header->numberofvariables : 0;
+    size_t edges = header->edges >= 0 ? (size_t)header->edges : 0;
+    size_t expected = sizeof(GraphFileHeader) + sizeof(int32_t) * ((n + 1) + (n * EDGE_KINDS + 1) + 2 * edges) + edges;
+    const int32_t *offsets = (const int32_t *)(header + 1);
+    if (header->numberofvariables < 0 || header->edges < 0 || header->edgeKinds != EDGE_KINDS || size < expected || offsets[n] != header->edges)
+    {
+        printf("INVALID GRAPH FILE.\n");
+        munmap(mapping, size);
+        exit(1);
+    }
+
+    // Check the arrays themselves, once...the solver indexes with them and never looks again
+    // Segments go up from 0 to edges with offsets at every variable's first one, and every entry holds
+    // a variable, a weight of at least 1 and the kind of its segment
+    const int32_t *segments = offsets + n + 1;
+    const int32_t *neighbors = segments + n * EDGE_KINDS + 1;
+    const int32_t *weights = neighbors + edges;
+    const unsigned char *kinds = (const unsigned char *)(weights + edges);
+    int valid = (segments[0] == 0 && segments[n * EDGE_KINDS] == header->edges);
+    for (size_t x = 0; valid && x <= n; x++)
+    {
+        valid = (offsets[x] == segments[x * EDGE_KINDS]);
+    }
+    for (size_t s = 0; valid && s < n * EDGE_KINDS; s++)
+    {
+        valid = (segments[s] <= segments[s + 1]);
+        for (int32_t e = segments[s]; valid && e < segments[s + 1]; e++)
+        {
+            valid = (neighbors[e] >= 0 && (size_t)neighbors[e] < n && weights[e] >= 1 && kinds[e] == s % EDGE_KINDS + 1);
+        }
+    }
+    if (!valid)
+    {
+        printf("INVALID GRAPH FILE.\n");
+        munmap(mapping, size);
+        exit(1);
+    }
+
+    graph->numberofvariables = (int)n;
+    graph->offsets = (int *)offsets;
+    graph->segments = graph->offsets + n + 1;
+    graph->neighbors = graph->segments + n * EDGE_KINDS + 1;
+    graph->weights = graph->neighbors + edges;
+    graph->kinds = (unsigned char *)(graph->weights + edges);
+    graph->numberofvalues = 0;
+    graph->day = NULL;
+    graph->period = NULL;
+    graph->sizes = NULL;
+    graph->capacities = NULL;
+    graph->capacityCount = 0;
+    graph->capacity = NULL;
+    graph->mapping = mapping;
+    graph->mappingSize = size;
+    setSoftKinds(graph, SOFT_KINDS);
+    return (int)n;
+}
+
+// Build the sparse constraint graph from the list of constraints, once at load time
+// Every constraint is stored on both of its variables so a variable's neighbours are one contiguous slice,
+// sorted by kind so that every kind has a segment of its own
+int buildConstraintGraph(ConstraintGraph *graph, int numberofvariables, const Constraint *list, int count)
+{
+    graph->numberofvariables = numberofvariables;
+    graph->numberofvalues = 0;
+    graph->day = NULL;
+    graph->period = NULL;
+    graph->sizes = NULL;
+    graph->capacities = NULL;
+    graph->capacityCount = 0;
+    graph->capacity = NULL;
+    graph->mapping = NULL;
+    setSoftKinds(graph, SOFT_KINDS);
+    graph->neighbors = NULL;
+    graph->weights = NULL;
+    graph->kinds = NULL;
+    graph->offsets = malloc(sizeof(int) * (numberofvariables + 1));
+    graph->segments = calloc((size_t)numberofvariables * EDGE_KINDS + 1, sizeof(int));
+    if (graph->offsets == NULL || graph->segments == NULL)
+    {
+        freeConstraintGraph(graph);
+        return 0;
+    }
+
+    // Count the neighbours of every variable and kind
+    for (int c = 0; c < count; c++)
+    {
+        int kind = list[c].kind;
+        graph->segments[list[c].first * EDGE_KINDS + kind]++;                          // Segment kind - 1, shifted by one
+        graph->segments[list[c].second * EDGE_KINDS + (kind == 4 ? 5 : kind)]++;
+    }
+    for (int s = 0; s < numberofvariables * EDGE_KINDS; s++)
+    {
+        graph->segments[s + 1] += graph->segments[s];
+    }
+    for (int i = 0; i <= numberofvariables; i++)
+    {
+        graph->offsets[i] = graph->segments[i * EDGE_KINDS];
+    }
+
+    int edges = graph->offsets[numberofvariables];
+    graph->neighbors = malloc(sizeof(int) * (edges > 0 ? edges : 1));
+    graph->weights = malloc(sizeof(int) * (edges > 0 ? edges : 1));
+    graph->kinds = malloc(sizeof(unsigned char) * (edges > 0 ? edges : 1));
+    int *next = malloc(sizeof(int) * (numberofvariables > 0 ? numberofvariables * EDGE_KINDS : 1));
+    if (graph->neighbors == NULL || graph->weights == NULL || graph->kinds == NULL || next == NULL)
+    {
+        free(next);
+        freeConstraintGraph(graph);
+        return 0;
+    }
+    memcpy(next, graph->segments, sizeof(int) * numberofvariables * EDGE_KINDS);
+
+    for (int c = 0; c < count; c++)
+    {
+        int i = list[c].first;
+        int j = list[c].second;
+        int constraint = list[c].kind;
+        int mirrored = (constraint == 4) ? 5 : constraint; // Xj sees Xi before it
+
+        int e = next[i * EDGE_KINDS + constraint - 1]++;
+        graph->neighbors[e] = j;
+        graph->weights[e] = list[c].weight;
+        graph->kinds[e] = (unsigned char)constraint;
+        e = next[j * EDGE_KINDS + mirrored - 1]++;
+        graph->neighbors[e] = i;
+        graph->weights[e] = list[c].weight;
+        graph->kinds[e] = (unsigned char)mirrored;
+    }
+
+    free(next);
+    return 1;
+}
+
+// Day and period of every timeslot, so no check divides by PERIODS_PER_DAY
+int initSlotTables(ConstraintGraph *graph, int numberofvalues)
+{
+    free(graph->day);
+    free(graph->period);
+    free(graph->capacity);
+    graph->numberofvalues = numberofvalues;
+    graph->day = malloc(sizeof(int) * (numberofvalues > 0 ? numberofvalues : 1));
+    graph->period = malloc(sizeof(int) * (numberofvalues > 0 ? numberofvalues : 1));
+    graph->capacity = (graph->capacities != NULL) ? malloc(sizeof(int) * (numberofvalues > 0 ? numberofvalues : 1)) : NULL;
+    if (graph->day == NULL || graph->period == NULL || (graph->capacities != NULL && graph->capacity == NULL))
+    {
+        return 0;
+    }
+    for (int slot = 0; slot < numberofvalues; slot++)
+    {
+        graph->day[slot] = slot / PERIODS_PER_DAY;
+        graph->period[slot] = slot % PERIODS_PER_DAY;
+        if (graph->capacity != NULL)
+            graph->capacity[slot] = graph->capacities[slot < graph->capacityCount ? slot : graph->capacityCount - 1];
+    }
+    return 1;
+}
+
+// Make the constraint types in kinds soft, "2,3" for example, and all others hard..."none" leaves them all hard
+// Returns 0 if kinds is not such a list, the graph is then unchanged
+int setSoftKinds(ConstraintGraph *graph, const char *kinds)
+{
+    unsigned char soft[EDGE_KINDS + 1] = {0};
+    if (strcmp(kinds, "none") != 0)
+    {
+        const char *c = kinds;
+        do
+        {
+            if (*c < '1' || *c > '4' || (c[1] != ',' && c[1] != '\0'))
+                return 0;
+            soft[*c - '0'] = 1;
+            c += (c[1] == ',') ? 2 : 1;
+        } while (*c != '\0' || c[-1] == ',');
+    }
+    soft[5] = soft[4]; // Type 4 seen from its second variable
+    memcpy(graph->soft, soft, sizeof(soft));
+    return 1;
+}
+
+// Read the size of every exam...one "exam,size" pair per line, exam 0-based, lines starting with # are comments
+// Exams that are not listed take one seat, as they do without a sizes file
+int readExamSizes(const char *filename, ConstraintGraph *graph)
+{
+    FILE *file = fopen(filename, "r");
+    if (file == NULL)
+    {
+        printf("ERROR OPENING SIZES FILE.\n");
+        exit(1);
+    }
+    free(graph->sizes);
+    graph->sizes = malloc(sizeof(int) * (graph->numberofvariables > 0 ? graph->numberofvariables : 1));
+    if (graph->sizes == NULL)
+    {
+        fclose(file);
+        return 0;
+    }
+    for (int x = 0; x < graph->numberofvariables; x++)
+    {
+        graph->sizes[x] = 1;
+    }
+
+    char buffer[256];
+    int line = 0;
+    while (fgets(buffer, sizeof(buffer), file) != NULL)
+    {
+        line++;
+        long exam, size;
+        char end;
+        char *start = buffer + strspn(buffer, " \t\r\n");
+        if (*start == '\0' || *start == '#' || strncmp(start, "exam", 4) == 0)
+            continue; // Blank, comment or header
+        if (sscanf(start, "%ld , %ld %c", &exam, &size, &end) != 2)
+        {
+            printf("INVALID SIZES LINE %d OF %s: EXPECTED exam,size.\n", line, filename);
+            exit(1);
+        }
+        if (exam < 0 || exam >= graph->numberofvariables || size < 0 || size > MAX_EXAM_SIZE)
+        {
+            printf("INVALID SIZES LINE %d OF %s: EXAM %ld OR SIZE %ld OUT OF RANGE.\n", line, filename, exam, size);
+            exit(1);
+        }
+        graph->sizes[exam] = (int)size;
+    }
+    fclose(file);
+    return 1;
+}
+
+// Apply a constraint diff...one "+i,j,kind[,weight]" line per constraint to add and one "-i,j,kind" line per
+// constraint to remove, in file order, lines starting with # are comments. Exams past the last one are new exams
+// The graph is rebuilt with the default soft kinds and no sizes. Returns the new number of variables
+int applyConstraintDiff(const char *filename, ConstraintGraph *graph)
+{
+    FILE *file = fopen(filename, "r");
+    if (file == NULL)
+    {
+        printf("ERROR OPENING DIFF FILE.\n");
+        exit(1);
+    }
+
+    // Every constraint once, the way an edge list has it...type 4 from its first variable, the others from the lower one
+    Constraint *list = NULL;
+    int count = 0, capacity = 0, numberofvariables = graph->numberofvariables;
+    for (int x = 0; x < numberofvariables; x++)
+    {
+        for (int e = graph->offsets[x]; e < graph->offsets[x + 1]; e++)
+        {
+            int y = graph->neighbors[e], kind = graph->kinds[e];
+            if (kind == 4 || (kind < 4 && x < y))
+                addConstraint(&list, &count, &capacity, x, y, kind, graph->weights[e]);
+        }
+    }
+
+    char buffer[256];
+    int line = 0;
+    while (fgets(buffer, sizeof(buffer), file) != NULL)
+    {
+        line++;
+        long i, j, kind, weight = 1;
+        char end;
+        char *start = buffer + strspn(buffer, " \t\r\n");
+        if (*start == '\0' || *start == '#')
+            continue; // Blank or comment
+        int fields = sscanf(start + 1, "%ld , %ld , %ld , %ld %c", &i, &j, &kind, &weight, &end);
+        if ((*start != '+' && *start != '-') || fields < 3 || fields > 4 || (*start == '-' && fields != 3))
+        {
+            printf("INVALID DIFF LINE %d OF %s: EXPECTED +i,j,kind[,weight] OR -i,j,kind.\n", line, filename);
+            exit(1);
+        }
+        if (i < 0 || j < 0 || i >= MAX_VARIABLES || j >= MAX_VARIABLES || i == j || kind < 1 || kind > 4 || weight < 1 || weight > MAX_WEIGHT)
+        {
+            printf("INVALID DIFF LINE %d OF %s: EXAM, CONSTRAINT TYPE OR WEIGHT OUT OF RANGE.\n", line, filename);
+            exit(1);
+        }
+
+        if (*start == '+')
+        {
+            addConstraint(&list, &count, &capacity, (int)i, (int)j, (int)kind, (int)weight);
+            if (i >= numberofvariables)
+                numberofvariables = (int)i + 1;
+            if (j >= numberofvariables)
+                numberofvariables = (int)j + 1;
+            continue;
+        }
+
+        // Types 1-3 hold both ways, so either order removes them
+        int c = 0;
+        while (c < count && !(list[c].kind == kind && ((list[c].first == i && list[c].second == j) ||
+                                                     (kind != 4 && list[c].first == j && list[c].second == i))))
+            c++;
+        if (c == count)
+        {
+            printf("INVALID DIFF LINE %d OF %s: %ld,%ld,%ld IS NOT A CONSTRAINT.\n", line, filename, i, j, kind);
+            exit(1);
+        }
+        list[c] = list[--count];
+    }
+    fclose(file);
+
+    freeConstraintGraph(graph);
+    if (!buildConstraintGraph(graph, numberofvariables, list, count))
+    {
+        printf("Memory allocation failed.\n");
+        exit(1);
+    }
+    free(list);
+    return numberofvariables;
+}
+
+// Read a timetable written by writeSchedule(), CSV or JSON...Xvalue[x] = its slot, -1 for the exams it does not
+// place or places on a day past the calendar. Needs the slot tables. Returns the number of exams placed
+int readSchedule(const char *filename, const ConstraintGraph *graph, int *Xvalue)
+{
+    FILE *file = fopen(filename, "r");
+    if (file == NULL)
+    {
+        printf("ERROR OPENING SCHEDULE FILE.\n");
+        exit(1);
+    }
+    for (int x = 0; x < graph->numberofvariables; x++)
+    {
+        Xvalue[x] = -1;
+    }
+
+    char buffer[256];
+    int line = 0, placed = 0;
+    while (fgets(buffer, sizeof(buffer), file) != NULL)
+    {
+        line++;
+        long exam, day, period;
+        char end;
+        char *start = buffer + strspn(buffer, " \t\r\n");
+        char *object = strstr(start, "{\"exam\"");
+        int fields;
+        if (object != NULL)
+            fields = sscanf(object, "{\"exam\": %ld, \"day\": %ld, \"period\": %ld }", &exam, &day, &period);
+        else if (*start == '\0' || *start == '#' || *start == '{' || *start == ']' || strncmp(start, "exam", 4) == 0)
+            continue; // Blank, comment, header or the rest of the JSON
+        else
+            fields = sscanf(start, "%ld , %ld , %ld %c", &exam, &day, &period, &end);
+        if (fields != 3)
+        {
+            printf("INVALID SCHEDULE LINE %d OF %s: EXPECTED exam,day,period.\n", line, filename);
+            exit(1);
+        }
+        if (exam < 0 || exam >= graph->numberofvariables || day < 0 || period < 0 || period >= PERIODS_PER_DAY)
+        {
+            printf("INVALID SCHEDULE LINE %d OF %s: EXAM %ld OR PERIOD %ld OUT OF RANGE.\n", line, filename, exam, period);
+            exit(1);
+        }
+        if (day * PERIODS_PER_DAY + period < graph->numberofvalues)
+        {
+            placed += (Xvalue[exam] < 0);
+            Xvalue[exam] = (int)(day * PERIODS_PER_DAY + period);
+        }
+    }
+    fclose(file);
+    return placed;
+}
+
+// Seats of every slot from a list like "500" or "500,300,300"...the last value holds for the slots after the list
+// Exams take one seat each unless readExamSizes() was called first. Returns 0 if list is not such a list
+int setCapacities(ConstraintGraph *graph, const char *list)
+{
+    int count = 1;
+    for (const char *c = list; *c != '\0'; c++)
+        count += (*c == ',');
+    int *capacities = malloc(sizeof(int) * count);
+    if (capacities == NULL)
+        return 0;
+
+    const char *c = list;
+    for (int k = 0; k < count; k++)
+    {
+        char *end;
+        long value = strtol(c, &end, 10);
+        if (end == c || (*end != ',' && *end != '\0') || value < 0 || value > INT_MAX / 2)
+        {
+            free(capacities);
+            return 0;
+        }
+        capacities[k] = (int)value;
+        c = end + 1;
+    }
+
+    if (graph->sizes == NULL)
+    {
+        graph->sizes = malloc(sizeof(int) * (graph->numberofvariables > 0 ? graph->numberofvariables : 1));
+        if (graph->sizes == NULL)
+        {
+            free(capacities);
+            return 0;
+        }
+        for (int x = 0; x < graph->numberofvariables; x++)
+            graph->sizes[x] = 1;
+    }
+    free(graph->capacities);
+    graph->capacities = capacities;
+    graph->capacityCount = count;
+    return 1;
+}
+
+void freeConstraintGraph(ConstraintGraph *graph)
+{
+    if (graph->mapping != NULL)
+    {
+        munmap(graph->mapping, graph->mappingSize); // The arrays live in the mapping
+        graph->mapping = NULL;
+    }
+    else
+    {
+        free(graph->offsets);
+        free(graph->segments);
+        free(graph->neighbors);
+        free(graph->weights);
+        free(graph->kinds);
+    }
+    free(graph->day);
+    free(graph->period);
+    free(graph->sizes);
+    free(graph->capacities);
+    free(graph->capacity);
+    graph->offsets = NULL;
+    graph->segments = NULL;
+    graph->neighbors = NULL;
+    graph->weights = NULL;
+    graph->kinds = NULL;
+    graph->day = NULL;
+    graph->period = NULL;
+    graph->sizes = NULL;
+    graph->capacities = NULL;
+    graph->capacity = NULL;
+}
+
+// Function to check if constraints are satisfied
+// One loop per kind of constraint, so there is no branch per pair
+// Returns the number of violated hard constraints, the weight of the violated soft ones goes to penalty (if not NULL)
+int satisfies(int *Xvalue, int numberofvariables, int numberofvalues, const ConstraintGraph *graph, int *penalty)
+{
+    const int *day = graph->day;
+    const int *period = graph->period;
+    int total[2] = {0, 0}; // Hard conflicts, soft penalty
+
+    // Check constraints...The four types of constraints we have
+    // Types 1-3 are stored on both variables and counted from the lower one, type 4 only from Xfirst
+    for (int i = 0; i < numberofvariables; i++)
+    {
+        const int *segment = graph->segments + i * EDGE_KINDS;
+        int value = Xvalue[i];
+
+        // Xi != Xj
+        const int *weights = graph->soft[1] ? graph->weights : NULL;
+        for (int e = segment[0]; e < segment[1]; e++)
+        {
+            int j = graph->neighbors[e];
+            total[graph->soft[1]] += ((value == Xvalue[j]) & (j > i)) * edgeWeight(weights, e);
+        }
+        // abs(Xi / 3 - Xj / 3) > 2
+        weights = graph->soft[2] ? graph->weights : NULL;
+        for (int e = segment[1]; e < segment[2]; e++)
+        {
+            int j = graph->neighbors[e];
+            total[graph->soft[2]] += ((abs(day[value] - day[Xvalue[j]]) <= 2) & (j > i)) * edgeWeight(weights, e);
+        }
+        // Xi / 3 != Xj / 3
+        weights = graph->soft[3] ? graph->weights : NULL;
+        for (int e = segment[2]; e < segment[3]; e++)
+        {
+            int j = graph->neighbors[e];
+            total[graph->soft[3]] += ((day[value] == day[Xvalue[j]]) & (j > i)) * edgeWeight(weights, e);
+        }
+        // (Xi / 3 == Xj / 3 && Xi % 3 < Xj % 3)
+        weights = graph->soft[4] ? graph->weights : NULL;
+        for (int e = segment[3]; e < segment[4]; e++)
+        {
+            int j = graph->neighbors[e];
+            total[graph->soft[4]] += !((day[value] == day[Xvalue[j]]) & (period[value] < period[Xvalue[j]])) * edgeWeight(weights, e);
+        }
+    }
+
+    // Slot capacities...every student over capacity is one more conflict
+    if (graph->capacity != NULL)
+    {
+        int *occupancy = calloc(numberofvalues > 0 ? numberofvalues : 1, sizeof(int));
+        if (occupancy == NULL)
+        {
+            printf("Memory allocation failed.\n");
+            exit(1);
+        }
+        for (int i = 0; i < numberofvariables; i++)
+        {
+            occupancy[Xvalue[i]] += graph->sizes[i];
+        }
+        for (int slot = 0; slot < numberofvalues; slot++)
+        {
+            total[0] += overflowOf(occupancy[slot], graph->capacity[slot]);
+        }
+        free(occupancy);
+    }
+
+    if (penalty != NULL)
+        *penalty = total[1];
+    return total[0]; // Total number of conflicts
+}
+
+// Build the conflict table for the current assignment
+// The table is read in O(1) per (variable, value) and kept up to date by assignVariable()
+int initConflictTable(ConflictTable *table, int *Xvalue, int numberofvariables, int numberofvalues, const ConstraintGraph *graph)
+{
+    int rows = numberofvariables > 0 ? numberofvariables : 1;
+    int slots = numberofvalues > 0 ? numberofvalues : 1;
+    int capacities = graph->capacity != NULL;
+    table->occupancy = capacities ? malloc(sizeof(int) * slots) : NULL;
+    table->slotMembers = capacities ? malloc(sizeof(int) * rows * slots) : NULL;
+    table->slotCount = capacities ? malloc(sizeof(int) * slots) : NULL;
+    table->slotIndex = capacities ? malloc(sizeof(int) * rows) : NULL;
+    table->scratch = capacities ? malloc(sizeof(int) * slots) : NULL;
+    table->bonus = NULL;
+    table->guides = NULL;
+    table->conflicts = malloc(sizeof(int) * numberofvariables * numberofvalues);
+    table->penalties = malloc(sizeof(int) * numberofvariables * numberofvalues);
+    table->members = malloc(sizeof(int) * rows);
+    table->position = malloc(sizeof(int) * rows);
+    table->softMembers = malloc(sizeof(int) * rows);
+    table->softPosition = malloc(sizeof(int) * rows);
+    if (table->conflicts == NULL || table->penalties == NULL || table->members == NULL || table->position == NULL ||
+        table->softMembers == NULL || table->softPosition == NULL || (capacities && (table->occupancy == NULL ||
+        table->slotMembers == NULL || table->slotCount == NULL || table->slotIndex == NULL || table->scratch == NULL)))
+    {
+        freeConflictTable(table);
+        return 0;
+    }
+
+    // Constraint 4 is violated for every value except the ordered ones on the same day,
+    // so every row starts from its type 4 constraints...counted if they are hard, weighed if they are soft
+    for (int u = 0; u < numberofvariables; u++)
+    {
+        int typeFour = 0;
+        for (int e = graph->segments[u * EDGE_KINDS + 3]; e < graph->segments[(u + 1) * EDGE_KINDS]; e++) // Kinds 4 and 5
+        {
+            typeFour += graph->soft[4] ? graph->weights[e] : 1;
+        }
+        int *hard = table->conflicts + u * numberofvalues;
+        int *soft = table->penalties + u * numberofvalues;
+        for (int value = 0; value < numberofvalues; value++)
+        {
+            hard[value] = graph->soft[4] ? 0 : typeFour;
+            soft[value] = graph->soft[4] ? typeFour : 0;
+        }
+    }
+
+    for (int x = 0; x < numberofvariables; x++)
+    {
+        updateConflictTable(table, x, Xvalue[x], +1, numberofvalues, graph);
+    }
+    table->cost = satisfies(Xvalue, numberofvariables, numberofvalues, graph, &table->penalty);
+
+    // Occupancy counters and the exams of every slot, kept up to date by assignVariable()
+    table->overflow = 0;
+    if (capacities)
+    {
+        memset(table->occupancy, 0, sizeof(int) * numberofvalues);
+        memset(table->slotCount, 0, sizeof(int) * numberofvalues);
+        for (int x = 0; x < numberofvariables; x++)
+        {
+            int slot = Xvalue[x];
+            table->occupancy[slot] += graph->sizes[x];
+            table->slotIndex[x] = table->slotCount[slot];
+            table->slotMembers[slot * numberofvariables + table->slotCount[slot]++] = x;
+        }
+        for (int slot = 0; slot < numberofvalues; slot++)
+        {
+            table->overflow += overflowOf(table->occupancy[slot], graph->capacity[slot]);
+        }
+    }
+
+    table->conflicted = 0;
+    table->softConflicted = 0;
+    for (int x = 0; x < numberofvariables; x++)
+    {
+        table->position[x] = -1;
+        table->softPosition[x] = -1;
+        updateConflicted(table, Xvalue, x, numberofvalues);
+    }
+    return 1;
+}
+
+void freeConflictTable(ConflictTable *table)
+{
+    free(table->conflicts);
+    free(table->penalties);
+    free(table->members);
+    free(table->position);
+    free(table->softMembers);
+    free(table->softPosition);
+    free(table->occupancy);
+    free(table->slotMembers);
+    free(table->slotCount);
+    free(table->slotIndex);
+    free(table->scratch);
+    table->conflicts = NULL;
+    table->penalties = NULL;
+    table->members = NULL;
+    table->position = NULL;
+    table->softMembers = NULL;
+    table->softPosition = NULL;
+    table->occupancy = NULL;
+    table->slotMembers = NULL;
+    table->slotCount = NULL;
+    table->slotIndex = NULL;
+    table->scratch = NULL;
+}
+
+// Put x in or take it out of one set of variables, in O(1)
+static void updateMembers(int *members, int *position, int *count, int x, int in)
+{
+    int index = position[x];
+
+    if (in && index < 0)
+    {
+        position[x] = *count;
+        members[(*count)++] = x;
+    }
+    else if (!in && index >= 0)
+    {
+        // The last member takes the place of x
+        int last = members[--(*count)];
+        members[index] = last;
+        position[last] = index;
+        position[x] = -1;
+    }
+}
+
+// Put x in or take it out of the conflicted sets after its row or its value changed, in O(1)
+// x is in the soft set only while it has a penalty and no conflict
+void updateConflicted(ConflictTable *table, const int *Xvalue, int x, int numberofvalues)
+{
+    int entry = x * numberofvalues + Xvalue[x];
+    int inConflict = table->conflicts[entry] > 0;
+
+    updateMembers(table->members, table->position, &table->conflicted, x, inConflict);
+    updateMembers(table->softMembers, table->softPosition, &table->softConflicted, x, !inConflict && table->penalties[entry] > 0);
+}
+
+// Add (sign = +1) or remove (sign = -1) the effect of X[x] = value on the rows of its neighbours e = begin ... end - 1,
+// all of one kind, each counted with its weight (1 if weights is NULL)
+static void updateKind(int *rows, const int *weights, int kind, int begin, int end, int value, int sign, int numberofvalues, const ConstraintGraph *graph)
+{
+    int day = graph->day[value];
+    int period = graph->period[value];
+    int days = numberofvalues / PERIODS_PER_DAY;
+    int dayStart = day * PERIODS_PER_DAY;
+
+    switch (kind)
+    {
+    case 1: // Xi != Xj
+        for (int e = begin; e < end; e++)
+        {
+            rows[graph->neighbors[e] * numberofvalues + value] += sign * edgeWeight(weights, e);
+        }
+        break;
+
+    case 2: // abs(Xi / 3 - Xj / 3) > 2...the days from day - 2 to day + 2
+    {
+        int first = (day - 2 < 0) ? 0 : day - 2;
+        int last = (day + 2 >= days) ? days - 1 : day + 2;
+        for (int e = begin; e < end; e++)
+        {
+            int *row = rows + graph->neighbors[e] * numberofvalues;
+            int delta = sign * edgeWeight(weights, e);
+            for (int d = first * PERIODS_PER_DAY; d < (last + 1) * PERIODS_PER_DAY; d++)
+            {
+                row[d] += delta;
+            }
+        }
+        break;
+    }
+
+    case 3: // Xi / 3 != Xj / 3
+        for (int e = begin; e < end; e++)
+        {
+            int *row = rows + graph->neighbors[e] * numberofvalues + dayStart;
+            int delta = sign * edgeWeight(weights, e);
+            for (int p = 0; p < PERIODS_PER_DAY; p++)
+            {
+                row[p] += delta;
+            }
+        }
+        break;
+
+    case 4: // x comes before its neighbour on the same day...only the satisfied values of the neighbour change
+        for (int e = begin; e < end; e++)
+        {
+            int *row = rows + graph->neighbors[e] * numberofvalues + dayStart;
+            int delta = sign * edgeWeight(weights, e);
+            for (int p = period + 1; p < PERIODS_PER_DAY; p++)
+            {
+                row[p] -= delta;
+            }
+        }
+        break;
+
+    case 5: // x comes after its neighbour on the same day
+        for (int e = begin; e < end; e++)
+        {
+            int *row = rows + graph->neighbors[e] * numberofvalues + dayStart;
+            int delta = sign * edgeWeight(weights, e);
+            for (int p = 0; p < period; p++)
+            {
+                row[p] -= delta;
+            }
+        }
+        break;
+    }
+}
+
+// Add (sign = +1) or remove (sign = -1) the effect of X[x] = value on the rows of its neighbours
+// Each kind is its own loop over its own segment of the neighbours of x, into the table of its kind,
+// and for hard kinds into the guide rows too when a strategy keeps them
+void updateConflictTable(ConflictTable *table, int x, int value, int sign, int numberofvalues, const ConstraintGraph *graph)
+{
+    const int *segment = graph->segments + x * EDGE_KINDS;
+
+    for (int kind = 1; kind <= EDGE_KINDS; kind++)
+    {
+        const int *weights;
+        int *rows = kindRows(table, graph, kind, &weights);
+        updateKind(rows, weights, kind, segment[kind - 1], segment[kind], value, sign, numberofvalues, graph);
+        if (table->guides != NULL && !graph->soft[kind])
+        {
+            updateKind(table->guides, table->bonus, kind, segment[kind - 1], segment[kind], value, sign, numberofvalues, graph);
+        }
+    }
+}
+
+// Move the students of x from slot previous to slot value...only the two counters change, so this is O(1)
+static void moveSlot(ConflictTable *table, int x, int previous, int value, const ConstraintGraph *graph)
+{
+    int *occupancy = table->occupancy;
+    int size = graph->sizes[x];
+    int before = overflowOf(occupancy[previous], graph->capacity[previous]) + overflowOf(occupancy[value], graph->capacity[value]);
+    occupancy[previous] -= size;
+    occupancy[value] += size;
+    int after = overflowOf(occupancy[previous], graph->capacity[previous]) + overflowOf(occupancy[value], graph->capacity[value]);
+    table->overflow += after - before;
+    table->cost += after - before;
+
+    // The last exam of previous takes the place of x
+    int n = graph->numberofvariables;
+    int index = table->slotIndex[x];
+    int last = table->slotMembers[previous * n + --table->slotCount[previous]];
+    table->slotMembers[previous * n + index] = last;
+    table->slotIndex[last] = index;
+    table->slotIndex[x] = table->slotCount[value];
+    table->slotMembers[value * n + table->slotCount[value]++] = x;
+}
+
+// Make the assignment X[x] = value and keep the conflict table, the cost and the penalty in step
+void assignVariable(ConflictTable *table, int *Xvalue, int x, int value, int numberofvalues, const ConstraintGraph *graph)
+{
+    int previous = Xvalue[x];
+    if (previous == value)
+        return;
+
+    int *row = table->conflicts + x * numberofvalues;
+    int *soft = table->penalties + x * numberofvalues;
+    table->cost += row[value] - row[previous];
+    table->penalty += soft[value] - soft[previous];
+    if (graph->capacity != NULL)
+        moveSlot(table, x, previous, value, graph);
+
+    updateConflictTable(table, x, previous, -1, numberofvalues, graph);
+    updateConflictTable(table, x, value, +1, numberofvalues, graph);
+    Xvalue[x] = value;
+
+    // Only x and its neighbours can have come in or out of conflict
+    updateConflicted(table, Xvalue, x, numberofvalues);
+    for (int e = graph->offsets[x]; e < graph->offsets[x + 1]; e++)
+    {
+        updateConflicted(table, Xvalue, graph->neighbors[e], numberofvalues);
+    }
+}
+
+// Is the constraint of the given kind between a variable with value a and its neighbour with value b violated?
+static int violated(int kind, int a, int b, const ConstraintGraph *graph)
+{
+    int sameDay = graph->day[a] == graph->day[b];
+    switch (kind)
+    {
+    case 1:
+        return a == b;
+    case 2:
+        return abs(graph->day[a] - graph->day[b]) <= 2;
+    case 3:
+        return sameDay;
+    case 4:
+        return !(sameDay && graph->period[a] < graph->period[b]);
+    default: // 5, the neighbour comes first
+        return !(sameDay && graph->period[b] < graph->period[a]);
+    }
+}
+
+// Breakout...one more unit of bonus on every violated hard constraint of x, on both copies of the constraint,
+// with the guide rows of x and of the neighbour updated for that constraint alone. Returns the constraints raised
+int raiseWeights(ConflictTable *table, const int *Xvalue, int x, int numberofvalues, const ConstraintGraph *graph)
+{
+    const int *segment = graph->segments + x * EDGE_KINDS;
+    int raised = 0;
+
+    for (int kind = 1; kind <= EDGE_KINDS; kind++)
+    {
+        if (graph->soft[kind])
+            continue;
+        int mirrored = (kind == 4) ? 5 : (kind == 5) ? 4 : kind;
+        for (int e = segment[kind - 1]; e < segment[kind]; e++)
+        {
+            int y = graph->neighbors[e];
+            if (!violated(kind, Xvalue[x], Xvalue[y], graph))
+                continue;
+
+            // The copy of the constraint stored on y
+            int f = graph->segments[y * EDGE_KINDS + mirrored - 1];
+            while (graph->neighbors[f] != x)
+                f++;
+            table->bonus[e]++;
+            table->bonus[f]++;
+
+            // Type 4 rows count every constraint and take back the satisfied values, see initConflictTable()
+            if (kind >= 4)
+            {
+                for (int value = 0; value < numberofvalues; value++)
+                {
+                    table->guides[y * numberofvalues + value]++;
+                    table->guides[x * numberofvalues + value]++;
+                }
+            }
+            updateKind(table->guides, NULL, kind, e, e + 1, Xvalue[x], +1, numberofvalues, graph);
+            updateKind(table->guides, NULL, mirrored, f, f + 1, Xvalue[y], +1, numberofvalues, graph);
+            raised++;
+        }
+    }
+    return raised;
+}
+
+// One draw from the conflicted set kept by assignVariable()...from the soft set once there are no conflicts,
+// any variable if there is neither. While slots are over capacity, half of the draws are an exam of one of them
+int RandomVariableConflict(int numberofvariables, const ConflictTable *table, const ConstraintGraph *graph, Rng *rng)
+{
+    if (table->overflow > 0 && (table->conflicted == 0 || rngBounded(rng, 2) == 0))
+    {
+        int chosen = -1, seen = 0;
+        for (int slot = 0; slot < graph->numberofvalues; slot++)
+        {
+            if (table->occupancy[slot] > graph->capacity[slot] && rngBounded(rng, ++seen) == 0)
+                chosen = slot;
+        }
+        return table->slotMembers[chosen * numberofvariables + rngBounded(rng, table->slotCount[chosen])];
+    }
+    if (table->conflicted > 0)
+    {
+        return table->members[rngBounded(rng, table->conflicted)];
+    }
+    if (table->softConflicted > 0)
+    {
+        return table->softMembers[rngBounded(rng, table->softConflicted)];
+    }
+    return (int)rngBounded(rng, numberofvariables);
+}
+
+// Row of x with the change of overflow added...cost - row[X[x]] + row[value] is the cost after X[x] = value
+// Without capacities that is the row of the conflict table, otherwise it is built in table->scratch
+const int *moveRow(ConflictTable *table, const int *Xvalue, int x, int numberofvalues, const ConstraintGraph *graph)
+{
+    const int *row = table->conflicts + x * numberofvalues;
+    if (graph->capacity == NULL)
+        return row;
+
+    const int *occupancy = table->occupancy;
+    const int *capacity = graph->capacity;
+    int size = graph->sizes[x];
+    int current = Xvalue[x];
+    for (int slot = 0; slot < numberofvalues; slot++)
+    {
+        table->scratch[slot] = row[slot] + overflowOf(occupancy[slot] + size, capacity[slot]) - overflowOf(occupancy[slot], capacity[slot]);
+    }
+    table->scratch[current] = row[current] + overflowOf(occupancy[current], capacity[current]) - overflowOf(occupancy[current] - size, capacity[current]);
+    return table->scratch;
+}
+
+// Change of the cost if X[x] became value, in O(1)...the entry of moveRow() for that value alone
+int moveDelta(const ConflictTable *table, const int *Xvalue, int x, int value, int numberofvalues, const ConstraintGraph *graph)
+{
+    const int *row = table->conflicts + x * numberofvalues;
+    int current = Xvalue[x];
+    int delta = row[value] - row[current];
+    if (graph->capacity != NULL && value != current)
+    {
+        const int *occupancy = table->occupancy;
+        const int *capacity = graph->capacity;
+        int size = graph->sizes[x];
+        delta += overflowOf(occupancy[value] + size, capacity[value]) - overflowOf(occupancy[value], capacity[value]);
+        delta -= overflowOf(occupancy[current], capacity[current]) - overflowOf(occupancy[current] - size, capacity[current]);
+    }
+    return delta;
+}
+
+// Function for alternative value...the fewest conflicts, then the lowest penalty
+int AlternativeAssignment(const int *Xvalue, int variable, int numberofvalues, ConflictTable *table, const ConstraintGraph *graph, int *bestCost, int *bestPenalty)
+{
+    const int *row = moveRow(table, Xvalue, variable, numberofvalues, graph);
+    const int *soft = table->penalties + variable * numberofvalues;
+    int current = Xvalue[variable];
+    int lowest, lowestSoft;
+    int bestValue = rowArgmin(row, soft, numberofvalues, current, &lowest, &lowestSoft);
+
+    // The cost and the penalty change by the difference of the two entries of their rows
+    *bestCost = (lowest == INT_MAX) ? INT_MAX : table->cost - row[current] + lowest;
+    *bestPenalty = (lowest == INT_MAX) ? INT_MAX : table->penalty - soft[current] + lowestSoft;
+    return bestValue;
+}
+
+// Scoring kernels...the lowest entry of a conflict table row, skipping the current value
+// Entries are compared on the conflicts row first and on the penalty row (soft) on ties
+// Both return the first value on ties, so the AVX2 and the scalar build make the same moves
+#if defined(__AVX2__)
+
+// Lowest of the 8 lanes of (best, bestSoft, index), the lower index on ties
+static int reduceArgmin(__m256i best, __m256i bestSoft, __m256i index, int *lowest, int *lowestSoft)
+{
+    int values[8], softs[8], indices[8];
+    _mm256_storeu_si256((__m256i *)values, best);
+    _mm256_storeu_si256((__m256i *)softs, bestSoft);
+    _mm256_storeu_si256((__m256i *)indices, index);
+
+    int bestValue = -1;
+    *lowest = INT_MAX;
+    *lowestSoft = INT_MAX;
+    for (int lane = 0; lane < 8; lane++)
+    {
+        int soft = softs[lane] < *lowestSoft || (softs[lane] == *lowestSoft && indices[lane] < bestValue);
+        if (indices[lane] >= 0 && (values[lane] < *lowest || (values[lane] == *lowest && soft)))
+        {
+            *lowest = values[lane];
+            *lowestSoft = softs[lane];
+            bestValue = indices[lane];
+        }
+    }
+    return bestValue;
+}
+
+// Lanes where (entries, softs) is below (best, bestSoft)
+static inline __m256i lexicographicBelow(__m256i entries, __m256i softs, __m256i best, __m256i bestSoft)
+{
+    __m256i tie = _mm256_and_si256(_mm256_cmpeq_epi32(best, entries), _mm256_cmpgt_epi32(bestSoft, softs));
+    return _mm256_or_si256(_mm256_cmpgt_epi32(best, entries), tie);
+}
+
+int rowArgmin(const int *row, const int *soft, int numberofvalues, int skip, int *lowest, int *lowestSoft)
+{
+    const __m256i step = _mm256_set1_epi32(8);
+    const __m256i skipped = _mm256_set1_epi32(skip);
+    __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i best = _mm256_set1_epi32(INT_MAX);
+    __m256i bestSoft = _mm256_set1_epi32(INT_MAX);
+    __m256i index = _mm256_set1_epi32(-1);
+    int value = 0;
+
+    for (; value + 8 <= numberofvalues; value += 8)
+    {
+        __m256i entries = _mm256_loadu_si256((const __m256i *)(row + value));
+        __m256i softs = _mm256_loadu_si256((const __m256i *)(soft + value));
+        __m256i better = _mm256_andnot_si256(_mm256_cmpeq_epi32(lanes, skipped), lexicographicBelow(entries, softs, best, bestSoft));
+        best = _mm256_blendv_epi8(best, entries, better);
+        bestSoft = _mm256_blendv_epi8(bestSoft, softs, better);
+        index = _mm256_blendv_epi8(index, lanes, better);
+        lanes = _mm256_add_epi32(lanes, step);
+    }
+
+    int bestValue = reduceArgmin(best, bestSoft, index, lowest, lowestSoft);
+    for (; value < numberofvalues; value++) // Tail
+    {
+        if (value != skip && (row[value] < *lowest || (row[value] == *lowest && soft[value] < *lowestSoft)))
+        {
+            *lowest = row[value];
+            *lowestSoft = soft[value];
+            bestValue = value;
+        }
+    }
+    return (bestValue < 0) ? skip : bestValue;
+}
+
+int rowArgminAllowed(const int *row, const int *soft, const int *expiry, int numberofvalues, int skip, int iteration, int threshold, int thresholdSoft, int *lowest, int *lowestSoft)
+{
+    const __m256i step = _mm256_set1_epi32(8);
+    const __m256i skipped = _mm256_set1_epi32(skip);
+    const __m256i now = _mm256_set1_epi32(iteration);
+    const __m256i limit = _mm256_set1_epi32(threshold);
+    const __m256i limitSoft = _mm256_set1_epi32(thresholdSoft);
+    __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i best = _mm256_set1_epi32(INT_MAX);
+    __m256i bestSoft = _mm256_set1_epi32(INT_MAX);
+    __m256i index = _mm256_set1_epi32(-1);
+    int value = 0;
+
+    for (; value + 8 <= numberofvalues; value += 8)
+    {
+        __m256i entries = _mm256_loadu_si256((const __m256i *)(row + value));
+        __m256i softs = _mm256_loadu_si256((const __m256i *)(soft + value));
+        __m256i expires = _mm256_loadu_si256((const __m256i *)(expiry + value));
+        // Allowed: expiry <= iteration, or the entries are below (threshold, thresholdSoft) (aspiration)
+        __m256i allowed = _mm256_or_si256(_mm256_xor_si256(_mm256_cmpgt_epi32(expires, now), _mm256_set1_epi32(-1)), lexicographicBelow(entries, softs, limit, limitSoft));
+        __m256i better = _mm256_and_si256(allowed, lexicographicBelow(entries, softs, best, bestSoft));
+        better = _mm256_andnot_si256(_mm256_cmpeq_epi32(lanes, skipped), better);
+        best = _mm256_blendv_epi8(best, entries, better);
+        bestSoft = _mm256_blendv_epi8(bestSoft, softs, better);
+        index = _mm256_blendv_epi8(index, lanes, better);
+        lanes = _mm256_add_epi32(lanes, step);
+    }
+
+    int bestValue = reduceArgmin(best, bestSoft, index, lowest, lowestSoft);
+    for (; value < numberofvalues; value++) // Tail
+    {
+        int aspiration = row[value] < threshold || (row[value] == threshold && soft[value] < thresholdSoft);
+        if (value != skip && (expiry[value] <= iteration || aspiration) &&
+            (row[value] < *lowest || (row[value] == *lowest && soft[value] < *lowestSoft)))
+        {
+            *lowest = row[value];
+            *lowestSoft = soft[value];
+            bestValue = value;
+        }
+    }
+    return (bestValue < 0) ? skip : bestValue;
+}
+
+#else
+
+int rowArgmin(const int *row, const int *soft, int numberofvalues, int skip, int *lowest, int *lowestSoft)
+{
+    int bestValue = skip;
+    *lowest = INT_MAX;
+    *lowestSoft = INT_MAX;
+    for (int value = 0; value < numberofvalues; value++)
+    {
+        if (value != skip && (row[value] < *lowest || (row[value] == *lowest && soft[value] < *lowestSoft)))
+        {
+            *lowest = row[value];
+            *lowestSoft = soft[value];
+            bestValue = value;
+        }
+    }
+    return bestValue;
+}
+
+int rowArgminAllowed(const int *row, const int *soft, const int *expiry, int numberofvalues, int skip, int iteration, int threshold, int thresholdSoft, int *lowest, int *lowestSoft)
+{
+    int bestValue = skip;
+    *lowest = INT_MAX;
+    *lowestSoft = INT_MAX;
+    for (int value = 0; value < numberofvalues; value++)
+    {
+        // Allowed: expiry <= iteration, or the entries are below (threshold, thresholdSoft) (aspiration)
+        int aspiration = row[value] < threshold || (row[value] == threshold && soft[value] < thresholdSoft);
+        if (value != skip && (expiry[value] <= iteration || aspiration) &&
+            (row[value] < *lowest || (row[value] == *lowest && soft[value] < *lowestSoft)))
+        {
+            *lowest = row[value];
+            *lowestSoft = soft[value];
+            bestValue = value;
+        }
+    }
+    return bestValue;
+}
+
+#endif
+
+// Binary trace...the file starts with "MCTRACE1" followed by TraceRecords
+// Records are buffered per thread and written in blocks, so tracing does no formatting
+void traceMove(TraceWriter *trace, int tryIndex, int change, int variable, int value, int cost)
+{
+    TraceRecord *record = &trace->records[trace->count++];
+    record->run = trace->run;
+    record->tryIndex = tryIndex;
+    record->change = change;
+    record->variable = variable;
+    record->value = value;
+    record->cost = cost;
+    if (trace->count == TRACE_BUFFER)
+    {
+        flushTrace(trace);
+    }
+}
+
+void flushTrace(TraceWriter *trace)
+{
+    if (trace->count == 0)
+        return;
+    pthread_mutex_lock(trace->lock);
+    fwrite(trace->records, sizeof(TraceRecord), trace->count, trace->file);
+    pthread_mutex_unlock(trace->lock);
+    trace->count = 0;
+}
@@ -0,0 +1,287 @@
+#ifndef CSP_H
+#define CSP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+
+// Log levels...what goes into the output file
+#define LOG_SUMMARY 0 // Run statistics and the summary only
+#define LOG_TRY 1     // Also the outcome of every try
+#define LOG_MOVE 2    // Also every move and every initial assignment
+
+#define TRACE_BUFFER 4096 // Moves buffered per thread before they are written to the trace file
+
+#define DEADLINE_CHECK 1024 // Moves between two looks at the clock when there is a --time-limit
+
+#define TABU_SIZE 10         // Default tabu tenure in moves, --tabu-size changes it
+#define WALK_PROBABILITY 0.2 // Default random walk probability, --walk-probability changes it
+
+// Tabu tenure...how long a value that was left stays tabu
+#define TENURE_FIXED 0    // tabuSize moves
+#define TENURE_DYNAMIC 1  // Random below tabuSize plus a share of the conflicted variables
+#define TENURE_REACTIVE 2 // Starts at tabuSize, grows while the search makes no progress
+
+// Start of every try
+#define INIT_RANDOM 0 // Every variable on a random value
+#define INIT_DSATUR 1 // Constructive, the most constrained variable first
+#define INIT_GREEDY 2 // Constructive, the variables in random order
+
+// Portfolio...workers with different strategies on the same run, sharing their best assignments
+#define PORTFOLIO "minconflicts,walk,tabu" // Default --portfolio list
+#define PORTFOLIO_SIZE 8                   // Most strategies a portfolio may list
+#define ELITE_SIZE 4                       // Assignments kept by the elite pool
+#define ELITE_PERIOD 1024                  // Moves between two publications of a worker's best assignment
+#define ELITE_KICK 0.01                    // Share of variables given a random value when a try starts from an elite
+
+#define ANNEAL_TEMPERATURE 0.5 // Default starting temperature, --temperature changes it
+#define ANNEAL_COOLING 0.0     // Default cooling rate per move, 0 = the rate that reaches ANNEAL_FINAL at maxChanges
+#define ANNEAL_FINAL 0.01      // Temperature at the end of a try when the cooling rate is derived
+
+// Annealing schedule...how the temperature falls
+#define COOLING_GEOMETRIC 0 // Multiplied by the cooling rate after every move
+#define COOLING_ADAPTIVE 1  // Cooled while enough moves are accepted, warmed while too few are
+#define COOLING_REHEATING 2 // Geometric, back to the starting temperature when the search is stuck
+
+// Timeslots per day...build with -DPERIODS_PER_DAY=N for another exam calendar
+#ifndef PERIODS_PER_DAY
+#define PERIODS_PER_DAY 3
+#endif
+
+#define EDGE_KINDS 5 // Kinds 1-4, plus 5 for a type 4 constraint seen from its second variable
+
+#define SOFT_KINDS "2" // Constraint types that are soft by default, --soft changes them
+
+#define GRAPH_MAGIC "MCGRAPH2"    // First bytes of a binary graph file
+#define EDGE_LIST_HEADER "i,j,kind" // First line of an edge list file...",weight" may follow it
+#define EDGE_LIST_WEIGHT ",weight"
+#define MAX_VARIABLES 100000000     // Highest exam number + 1 an edge list may use
+#define MAX_WEIGHT 1000000          // Highest weight an edge list may give a constraint
+#define MAX_EXAM_SIZE 100000        // Highest size a sizes file may give an exam
+
+// structs
+typedef struct
+{
+    uint32_t s[4]; // xoshiro128** state, never all zero
+} Rng;
+
+typedef struct
+{
+    int first;  // Xfirst...for type 4 the variable that comes first
+    int second; // Xsecond
+    int kind;   // Constraint type 1-4
+    int weight; // Penalty when the constraint is soft and violated
+} Constraint;
+
+typedef struct
+{
+    int numberofvariables;
+    int *offsets;         // Neighbours of x are neighbors[offsets[x]] ... neighbors[offsets[x + 1] - 1]
+    int *segments;        // Neighbours of x of kind k start at neighbors[segments[x * EDGE_KINDS + k - 1]], sorted by kind
+    int *neighbors;
+    unsigned char *kinds; // Constraint type (1-4) of each neighbour...5 is a type 4 constraint seen from its second variable
+    int *weights;         // Weight of the constraint with each neighbour
+    unsigned char soft[EDGE_KINDS + 1]; // soft[kind] = 1 if violations of that kind are a weighted penalty, not a conflict
+    int numberofvalues;   // Timeslots of the calendar the tables below were built for
+    int *day;             // day[slot] = slot / PERIODS_PER_DAY
+    int *period;          // period[slot] = slot % PERIODS_PER_DAY
+    int *sizes;           // Students of each exam...NULL if slots have no capacity
+    int *capacities;      // --capacity list, capacities[k] seats in slot k, the last one for the slots after it
+    int capacityCount;
+    int *capacity;        // capacity[slot], built from capacities with day and period
+    void *mapping;        // Binary graph file the arrays above point into...NULL if they were allocated
+    size_t mappingSize;
+} ConstraintGraph;
+
+// Start of a binary graph file, see writeConstraintGraph()
+typedef struct
+{
+    char magic[8]; // GRAPH_MAGIC
+    int32_t numberofvariables;
+    int32_t edges;     // Entries of neighbors, weights and kinds...every constraint is stored twice
+    int32_t edgeKinds; // EDGE_KINDS of the program that wrote the file
+    int32_t reserved;
+} GraphFileHeader;
+
+typedef struct
+{
+    int *conflicts; // conflicts[x * numberofvalues + value] = violated hard constraints of x if x took value
+    int cost;       // Total number of violated hard constraints under the current assignment, plus overflow
+    int *penalties; // penalties[x * numberofvalues + value] = weight of the violated soft constraints of x if x took value
+    int penalty;    // Total weight of the violated soft constraints
+    int *members;   // Variables in conflict under the current assignment, in no particular order
+    int *position;  // Index of x in members...-1 if x is not in conflict
+    int conflicted; // Number of members
+    int *softMembers; // Variables with a soft penalty but no conflict, the same way
+    int *softPosition;
+    int softConflicted;
+    int *occupancy;   // occupancy[slot] = students of the exams in slot...the arrays below are NULL without capacities
+    int overflow;     // Students over capacity, summed over the slots
+    int *slotMembers; // Exams in slot are slotMembers[slot * numberofvariables] ... in no particular order
+    int *slotCount;   // Exams in each slot
+    int *slotIndex;   // Index of x among the exams of its slot
+    int *scratch;     // Row built by moveRow()
+    int *bonus;       // Extra weight of the hard constraint with each neighbour...owned by the strategy, NULL if it has none
+    int *guides;      // guides[x * numberofvalues + value] = extra weight of the violated hard constraints of x if x took value
+} ConflictTable;
+
+// One move in the binary trace file
+typedef struct
+{
+    int32_t run;
+    int32_t tryIndex;
+    int32_t change;
+    int32_t variable;
+    int32_t value; // Value of the variable after the move
+    int32_t cost;  // Cost after the move
+} TraceRecord;
+
+typedef struct
+{
+    FILE *file;            // Trace file shared by all threads
+    pthread_mutex_t *lock; // Guards file
+    int run;               // Run being traced
+    int count;
+    TraceRecord records[TRACE_BUFFER];
+} TraceWriter;
+
+// One assignment of the elite pool...a seqlock, readers retry while a writer is copying
+typedef struct
+{
+    atomic_uint sequence; // Odd while a writer is copying
+    atomic_int cost;      // INT_MAX while the slot is empty
+    atomic_int penalty;   // Penalty at cost
+    atomic_int *Xvalue;
+} EliteSlot;
+
+// Best assignments shared by the workers of a portfolio run...no locks, a writer that finds its slot busy gives up
+typedef struct
+{
+    int numberofvariables;
+    EliteSlot slots[ELITE_SIZE];
+} ElitePool;
+
+// Parameters shared by every run
+typedef struct
+{
+    int maxTries;
+    int maxChanges;
+    double p;     // Random walk probability
+    int tabuSize;   // Tabu tenure in moves
+    int tabuTenure; // TENURE_FIXED, TENURE_DYNAMIC or TENURE_REACTIVE
+    int logLevel;
+    double temperature; // Starting temperature of annealing
+    double coolingRate; // Factor per move...0 to derive it from maxChanges
+    int cooling;        // COOLING_GEOMETRIC, COOLING_ADAPTIVE or COOLING_REHEATING
+    int init;           // INIT_RANDOM, INIT_DSATUR or INIT_GREEDY
+    double deadline;    // wallClock() at which every run stops...0 for no time limit
+    int targetCost;     // A run stops once its cost is at most this...-1 for none
+    const int *start;   // Assignment the first try of every run starts from, -1 for a variable init places...NULL for none
+    int startEveryTry;  // Every try starts from start, not only the first
+    int stopAtSolution; // --first-solution: a run without conflicts ends there and stops the others through stop
+} SolverParams;
+
+// State of one run...every thread owns one and reuses it from run to run
+typedef struct
+{
+    const ConstraintGraph *graph;
+    const SolverParams *params;
+    int numberofvariables;
+    int numberofvalues;
+    int *Xvalue;
+    ConflictTable table;
+    Rng rng;
+    long long moves; // Summed over every try, more than an int holds on long runs
+    int bestCost;    // Lowest cost of the run so far
+    int bestPenalty; // Lowest penalty at bestCost
+    int timedOut;    // The run was stopped by the deadline
+    double solvedAt; // wallClock() when the cost first reached 0...0 if it never did, set by solve()
+    ElitePool *elite; // Shared with the other workers of a portfolio run...NULL otherwise
+    int *bestXvalue;  // Assignment at bestCost...NULL if it is not kept
+    int published;    // bestXvalue is already in the elite pool
+    void *data;   // Owned by the strategy
+} SearchState;
+
+// A move rule for the engine in solver.c...hooks left NULL are skipped
+typedef struct
+{
+    const char *name;       // Value of --strategy
+    const char *outputName; // Default results file
+    int (*start)(SearchState *search);                                             // Allocate the data of a thread...0 if that failed
+    void (*restart)(SearchState *search);                                          // A new try begins
+    int (*chooseValue)(SearchState *search, int x, int *newCost, int *newPenalty); // New value of x...its current value leaves x alone
+    void (*moved)(SearchState *search, int x, int previous);                       // x was just changed from previous
+    void (*finish)(SearchState *search);                                           // Free the data of a thread
+} Strategy;
+
+extern const Strategy minConflictsStrategy; // Best value, kept only if it does not make things worse
+extern const Strategy walkStrategy;         // Random value with probability p, otherwise the best one
+extern const Strategy tabuStrategy;         // Best value that is not tabu
+extern const Strategy annealStrategy;       // Random value, worse ones accepted with a probability that falls over time
+extern const Strategy breakoutStrategy;     // Best value under constraint weights that grow at local minima
+
+// Functions signature
+// csp.c...constraint model, evaluator, random numbers and trace
+void addConstraint(Constraint **list, int *count, int *capacity, int first, int second, int kind, int weight);
+int readConstraintsMatrix(const char *filename, ConstraintGraph *graph);
+int readConstraintsEdges(const char *filename, ConstraintGraph *graph);
+int loadConstraints(const char *filename, ConstraintGraph *graph);
+int writeConstraintGraph(const char *filename, const ConstraintGraph *graph);
+int writeSchedule(const char *filename, const int *Xvalue, const ConstraintGraph *graph, int collisions, int penalty);
+int mapConstraintGraph(const char *filename, ConstraintGraph *graph);
+int buildConstraintGraph(ConstraintGraph *graph, int numberofvariables, const Constraint *list, int count);
+int initSlotTables(ConstraintGraph *graph, int numberofvalues);
+int setSoftKinds(ConstraintGraph *graph, const char *kinds);
+int readExamSizes(const char *filename, ConstraintGraph *graph);
+int setCapacities(ConstraintGraph *graph, const char *list);
+int applyConstraintDiff(const char *filename, ConstraintGraph *graph);
+int readSchedule(const char *filename, const ConstraintGraph *graph, int *Xvalue);
+void freeConstraintGraph(ConstraintGraph *graph);
+int satisfies(int *Xvalue, int numberofvariables, int numberofvalues, const ConstraintGraph *graph, int *penalty);
+int initConflictTable(ConflictTable *table, int *Xvalue, int numberofvariables, int numberofvalues, const ConstraintGraph *graph);
+void updateConflictTable(ConflictTable *table, int x, int value, int sign, int numberofvalues, const ConstraintGraph *graph);
+void freeConflictTable(ConflictTable *table);
+void updateConflicted(ConflictTable *table, const int *Xvalue, int x, int numberofvalues);
+void assignVariable(ConflictTable *table, int *Xvalue, int x, int value, int numberofvalues, const ConstraintGraph *graph);
+int raiseWeights(ConflictTable *table, const int *Xvalue, int x, int numberofvalues, const ConstraintGraph *graph);
+int RandomVariableConflict(int numberofvariables, const ConflictTable *table, const ConstraintGraph *graph, Rng *rng);
+const int *moveRow(ConflictTable *table, const int *Xvalue, int x, int numberofvalues, const ConstraintGraph *graph);
+int moveDelta(const ConflictTable *table, const int *Xvalue, int x, int value, int numberofvalues, const ConstraintGraph *graph);
+int AlternativeAssignment(const int *Xvalue, int variable, int numberofvalues, ConflictTable *table, const ConstraintGraph *graph, int *bestCost, int *bestPenalty);
+int rowArgmin(const int *row, const int *soft, int numberofvalues, int skip, int *lowest, int *lowestSoft);
+int rowArgminAllowed(const int *row, const int *soft, const int *expiry, int numberofvalues, int skip, int iteration, int threshold, int thresholdSoft, int *lowest, int *lowestSoft);
+int *initialize(int *Xvalue, int numberofvariables, int numberofvalues, FILE *outputFile, Rng *rng);
+int *initializeGreedy(int *Xvalue, int numberofvariables, int numberofvalues, const ConstraintGraph *graph, const int *start, int saturation, FILE *outputFile, Rng *rng);
+void rngSeed(Rng *rng, uint64_t seed);
+uint32_t rngNext(Rng *rng);
+uint32_t rngBounded(Rng *rng, uint32_t range);
+void traceMove(TraceWriter *trace, int tryIndex, int change, int variable, int value, int cost);
+void flushTrace(TraceWriter *trace);
+
+// solver.c...the search engine
+const Strategy *findStrategy(const char *name);
+int findTenure(const char *name);
+int findCooling(const char *name);
+int findInit(const char *name);
+const char *nameOfTenure(int tenure);
+const char *nameOfCooling(int cooling);
+const char *nameOfInit(int init);
+double wallClock(void);
+int initElitePool(ElitePool *pool, int numberofvariables);
+void clearElitePool(ElitePool *pool);
+int publishElite(ElitePool *pool, const int *Xvalue, int cost, int penalty);
+int readElite(ElitePool *pool, int *Xvalue, Rng *rng);
+void freeElitePool(ElitePool *pool);
+int solve(const Strategy *strategy, SearchState *search, FILE *outputFile, atomic_int *stop, TraceWriter *trace);
+
+// main.c and bench.c...command line
+int parseInt(const char *text, const char *name, int minimum);
+double parseDouble(const char *text, const char *name, double minimum, double maximum);
+int parseStrategyList(const char *text, const char *name, const Strategy **list, int maximum);
+int benchMain(int argc, char *argv[]);
+
+#endif
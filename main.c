@@ -0,0 +1,1275 @@
+// Build: gcc -O2 -Wall -pthread -o mc main.c csp.c solver.c bench.c -lm
+// Add -march=native (or -mavx2) for the AVX2 scoring kernels in csp.c
+// Benchmark: mc bench --help
+// Binary instance: mc convert BetterCSVview.csv instance.bin, then -i instance.bin
+#include <stdio.h>
+#include <getopt.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <time.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "csp.h"
+
+// structs
+typedef struct
+{
+    int done; // The run finished...0 if it was cancelled or never started
+    long long moves;
+    int bestCollisions;
+    int bestPenalty; // Soft penalty at bestCollisions
+    int timedOut;    // Stopped by --time-limit
+    double executionTime;
+    FILE *log; // Output of this run, copied into the output file in run order
+} RunResult;
+
+typedef struct
+{
+    const ConstraintGraph *graph;
+    const Strategy *strategy;
+    SolverParams params;
+    int numberofvariables;
+    int numberofvalues;
+    int PrecedureRestarts;
+    int firstSolutionWins;
+    FILE *traceFile;           // NULL when --trace is not given
+    pthread_mutex_t traceLock; // Guards traceFile
+    uint64_t seed;        // Run r uses its own random state seeded with seed + r
+    pthread_mutex_t lock; // Guards nextRun
+    int nextRun;
+    atomic_int solved; // Raised by the first run that finds a solution
+    RunResult *results;
+    int *bestXvalue; // Best assignment of all runs, guarded by lock...NULL if it is not kept
+    int bestCollisions;
+    int bestPenalty;
+} RestartPool;
+
+// One worker of a portfolio run...keeps its search state from run to run
+typedef struct
+{
+    RestartPool *pool;
+    const Strategy *strategy;
+    int index; // Worker w of run r is seeded with seed + r * workers + w
+    int workers;
+    int run;
+    atomic_int *stop; // Raised by the worker that finds a solution
+    SearchState search;
+    TraceWriter *trace;
+    FILE *log;
+    int done;
+    double executionTime;
+} PortfolioWorker;
+
+// Functions signature
+void printUsage(const char *program);
+int readParameter(const char *prompt, int minimum);
+void *restartWorker(void *arg);
+int runPortfolio(RestartPool *pool, const Strategy **portfolio, int portfolioCount, int workers, int threadCount);
+void *portfolioWorker(void *arg);
+void copyLog(FILE *log, FILE *outputFile);
+void keepBest(RestartPool *pool, const int *Xvalue, int collisions, int penalty);
+int runRestarts(RestartPool *pool, const Strategy **portfolio, int portfolioCount, int threads);
+int findMinDays(RestartPool *pool, ConstraintGraph *graph, const Strategy **portfolio, int portfolioCount, int threads, int maxDays, FILE *outputFile);
+void discardResults(RunResult *results, int count);
+
+int main(int argc, char *argv[])
+{
+    // Parameters left at -1 are asked for on the terminal
+    int maxTries = -1, maxChanges = -1, days = -1, PrecedureRestarts = -1;
+    int threads = 0, firstSolutionWins = 0, logLevel = LOG_SUMMARY;
+    int minDays = 0; // --days is the number of days, not the most the search may use
+    double timeLimit = 0.0; // Seconds...0 for none
+    int targetCost = -1;    // None
+    int tabuSize = TABU_SIZE;
+    const char *tenureName = "fixed";
+    double temperature = ANNEAL_TEMPERATURE, coolingRate = ANNEAL_COOLING;
+    const char *coolingName = "geometric";
+    const char *initName = NULL; // random, or dsatur for the exams a --warm-start does not place
+    const char *softKinds = SOFT_KINDS;
+    const char *sizesName = NULL; // No exam sizes
+    const char *capacity = NULL;  // No slot capacities
+    double p = WALK_PROBABILITY; // e.g p = 0.2 = 20% probability for random walk
+    const Strategy *strategy = &minConflictsStrategy;
+    const Strategy *portfolio[PORTFOLIO_SIZE];
+    int portfolioCount = 0; // No portfolio
+    const char *portfolioName = NULL;
+    const char *inputName = "BetterCSVview.csv";
+    const char *traceName = NULL;
+    const char *scheduleName = NULL; // No timetable file
+    const char *warmName = NULL;     // No previous timetable
+    const char *diffName = NULL;     // No constraint diff
+    const char *outputName = NULL; // Default depends on the strategy
+    uint64_t seed = (uint64_t)time(NULL); // --seed N replays the same runs
+
+    // mc convert IN OUT...writes the binary graph file that -i reads without parsing
+    if (argc > 1 && strcmp(argv[1], "convert") == 0)
+    {
+        if (argc != 4)
+        {
+            printf("Usage: %s convert INPUT.csv OUTPUT.bin\n", argv[0]);
+            return 1;
+        }
+        ConstraintGraph graph;
+        int numberofvariables = loadConstraints(argv[2], &graph);
+        int written = writeConstraintGraph(argv[3], &graph);
+        if (written)
+        {
+            printf("%d VARIABLES, %d CONSTRAINTS WRITTEN TO %s\n", numberofvariables, graph.offsets[numberofvariables] / 2, argv[3]);
+        }
+        freeConstraintGraph(&graph);
+        return written ? 0 : 1;
+    }
+
+    // mc bench ... has options of its own
+    if (argc > 1 && strcmp(argv[1], "bench") == 0)
+    {
+        return benchMain(argc - 1, argv + 1);
+    }
+
+    static const struct option options[] = {
+        {"strategy", required_argument, NULL, 'S'},
+        {"tries", required_argument, NULL, 't'},
+        {"changes", required_argument, NULL, 'c'},
+        {"days", required_argument, NULL, 'd'},
+        {"restarts", required_argument, NULL, 'r'},
+        {"threads", required_argument, NULL, 'j'},
+        {"first-solution", no_argument, NULL, 'f'},
+        {"seed", required_argument, NULL, 's'},
+        {"input", required_argument, NULL, 'i'},
+        {"output", required_argument, NULL, 'o'},
+        {"log-level", required_argument, NULL, 'v'},
+        {"trace", required_argument, NULL, 'b'},
+        {"walk-probability", required_argument, NULL, 'p'},
+        {"tabu-size", required_argument, NULL, 'T'},
+        {"tabu-tenure", required_argument, NULL, 'R'},
+        {"temperature", required_argument, NULL, 'K'},
+        {"cooling-rate", required_argument, NULL, 'a'},
+        {"cooling", required_argument, NULL, 'm'},
+        {"init", required_argument, NULL, 'g'},
+        {"soft", required_argument, NULL, 'k'},
+        {"sizes", required_argument, NULL, 'z'},
+        {"capacity", required_argument, NULL, 'C'},
+        {"portfolio", required_argument, NULL, 'P'},
+        {"time-limit", required_argument, NULL, 'L'},
+        {"target-cost", required_argument, NULL, 'G'},
+        {"schedule", required_argument, NULL, 'w'},
+        {"min-days", no_argument, NULL, 'D'},
+        {"warm-start", required_argument, NULL, 'W'},
+        {"diff", required_argument, NULL, 'X'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}};
+
+    int option;
+    while ((option = getopt_long(argc, argv, "S:t:c:d:r:j:fs:i:o:v:b:p:T:R:K:a:m:g:k:z:C:P:L:G:w:DW:X:h", options, NULL)) != -1)
+    {
+        switch (option)
+        {
+        case 'S':
+            strategy = findStrategy(optarg);
+            if (strategy == NULL)
+            {
+                fprintf(stderr, "Invalid value for --strategy: %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 't':
+            maxTries = parseInt(optarg, "tries", 1);
+            break;
+        case 'c':
+            maxChanges = parseInt(optarg, "changes", 1);
+            break;
+        case 'd':
+            days = parseInt(optarg, "days", 1);
+            break;
+        case 'r':
+            PrecedureRestarts = parseInt(optarg, "restarts", 1);
+            break;
+        case 'j':
+            threads = parseInt(optarg, "threads", 0);
+            break;
+        case 'f':
+            firstSolutionWins = 1;
+            break;
+        case 's':
+        {
+            char *end;
+            seed = strtoull(optarg, &end, 10);
+            if (*optarg == '\0' || *end != '\0')
+            {
+                fprintf(stderr, "Invalid value for --seed: %s\n", optarg);
+                return 1;
+            }
+            break;
+        }
+        case 'i':
+            inputName = optarg;
+            break;
+        case 'o':
+            outputName = optarg;
+            break;
+        case 'v':
+            logLevel = parseInt(optarg, "log-level", LOG_SUMMARY);
+            if (logLevel > LOG_MOVE)
+            {
+                fprintf(stderr, "Invalid value for --log-level: %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 'b':
+            traceName = optarg;
+            break;
+        case 'p':
+        {
+            char *end;
+            p = strtod(optarg, &end);
+            if (*optarg == '\0' || *end != '\0' || p < 0.0 || p > 1.0)
+            {
+                fprintf(stderr, "Invalid value for --walk-probability: %s\n", optarg);
+                return 1;
+            }
+            break;
+        }
+        case 'T':
+            tabuSize = parseInt(optarg, "tabu-size", 1);
+            break;
+        case 'R':
+            if (findTenure(optarg) < 0)
+            {
+                fprintf(stderr, "Invalid value for --tabu-tenure: %s\n", optarg);
+                return 1;
+            }
+            tenureName = optarg;
+            break;
+        case 'K':
+            temperature = parseDouble(optarg, "temperature", 0.0, 1e9);
+            break;
+        case 'a':
+            coolingRate = parseDouble(optarg, "cooling-rate", 0.0, 1.0);
+            break;
+        case 'm':
+            if (findCooling(optarg) < 0)
+            {
+                fprintf(stderr, "Invalid value for --cooling: %s\n", optarg);
+                return 1;
+            }
+            coolingName = optarg;
+            break;
+        case 'g':
+            if (findInit(optarg) < 0)
+            {
+                fprintf(stderr, "Invalid value for --init: %s\n", optarg);
+                return 1;
+            }
+            initName = optarg;
+            break;
+        case 'k':
+        {
+            ConstraintGraph check; // Only its soft[] is set
+            if (!setSoftKinds(&check, optarg))
+            {
+                fprintf(stderr, "Invalid value for --soft: %s\n", optarg);
+                return 1;
+            }
+            softKinds = optarg;
+            break;
+        }
+        case 'z':
+            sizesName = optarg;
+            break;
+        case 'C':
+            capacity = optarg;
+            break;
+        case 'P':
+            portfolioCount = parseStrategyList(optarg, "portfolio", portfolio, PORTFOLIO_SIZE);
+            portfolioName = optarg;
+            break;
+        case 'L':
+            timeLimit = parseDouble(optarg, "time-limit", 1e-3, 1e9);
+            break;
+        case 'G':
+            targetCost = parseInt(optarg, "target-cost", 0);
+            break;
+        case 'w':
+            scheduleName = optarg;
+            break;
+        case 'D':
+            minDays = 1;
+            break;
+        case 'W':
+            warmName = optarg;
+            break;
+        case 'X':
+            diffName = optarg;
+            break;
+        case 'h':
+            printUsage(argv[0]);
+            return 0;
+        default:
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (optind < argc)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (sizesName != NULL && capacity == NULL)
+    {
+        fprintf(stderr, "--sizes needs --capacity\n");
+        return 1;
+    }
+    if (warmName != NULL && minDays)
+    {
+        fprintf(stderr, "--warm-start and --min-days cannot be combined\n");
+        return 1;
+    }
+    if (initName == NULL)
+    {
+        initName = (warmName != NULL) ? "dsatur" : "random";
+    }
+    if (outputName == NULL)
+    {
+        outputName = (portfolioCount > 0) ? "PORTFOLIO.txt" : strategy->outputName;
+    }
+
+    // Parameters of the strategies that run...one, or every strategy of the portfolio
+    int usesWalk = (portfolioCount == 0) ? (strategy == &walkStrategy) : 0;
+    int usesTabu = (portfolioCount == 0) ? (strategy == &tabuStrategy) : 0;
+    int usesAnneal = (portfolioCount == 0) ? (strategy == &annealStrategy) : 0;
+    for (int k = 0; k < portfolioCount; k++)
+    {
+        usesWalk |= (portfolio[k] == &walkStrategy);
+        usesTabu |= (portfolio[k] == &tabuStrategy);
+        usesAnneal |= (portfolio[k] == &annealStrategy);
+    }
+
+    // Anything not given on the command line is asked for
+    if (maxTries < 0)
+        maxTries = readParameter("Enter the number of tries (random restarts): ", 1);
+    if (maxChanges < 0)
+        maxChanges = readParameter("Enter the number of changes (maxChanges): ", 1);
+    if (days < 0)
+        days = readParameter("Enter the number of days: ", 1);
+    if (PrecedureRestarts < 0)
+        PrecedureRestarts = readParameter("Enter the number of procedure restarts: ", 1);
+    int numberofvalues = days * PERIODS_PER_DAY; // Timeslots = days * 3
+
+    // The time limit counts from here...loading the constraints is part of it
+    double deadline = (timeLimit > 0.0) ? wallClock() + timeLimit : 0.0;
+
+    // Open file to save results
+    FILE *outputFile = fopen(outputName, "w"); // Open file to save results
+    if (outputFile == NULL)
+    {
+        printf("ERROR OPENING TXT FILE.\n");
+        return 1;
+    }
+
+    if (portfolioCount > 0)
+        fprintf(outputFile, "PORTFOLIO: %s\n", portfolioName);
+    else
+        fprintf(outputFile, "STRATEGY: %s\n", strategy->name);
+    fprintf(outputFile, "MAX TRIES: %d\n", maxTries);
+    fprintf(outputFile, "MAX CHANGES: %d\n", maxChanges);
+    if (minDays)
+        fprintf(outputFile, "MIN DAYS SEARCH: 1 TO %d\n", days);
+    else
+        fprintf(outputFile, "NUMBER OF DAYS: %d\n", days);
+    fprintf(outputFile, "NUMBER OF PROCEDURE RESTARTS: %d\n", PrecedureRestarts);
+    fprintf(outputFile, "NUMBER OF THREADS: %d\n", threads);
+    if (usesWalk)
+        fprintf(outputFile, "WALK PROBABILITY: %.2f\n", p);
+    if (usesTabu)
+    {
+        fprintf(outputFile, "TABU SIZE: %d\n", tabuSize);
+        fprintf(outputFile, "TABU TENURE: %s\n", tenureName);
+    }
+    if (usesAnneal)
+    {
+        fprintf(outputFile, "TEMPERATURE: %g\n", temperature);
+        if (coolingRate > 0.0)
+            fprintf(outputFile, "COOLING RATE: %g\n", coolingRate);
+        else
+            fprintf(outputFile, "COOLING RATE: down to %g at the end of a try\n", ANNEAL_FINAL);
+        fprintf(outputFile, "COOLING: %s\n", coolingName);
+    }
+    fprintf(outputFile, "INIT: %s\n", initName);
+    fprintf(outputFile, "SOFT KINDS: %s\n", softKinds);
+    if (capacity != NULL)
+    {
+        fprintf(outputFile, "EXAM SIZES: %s\n", (sizesName != NULL) ? sizesName : "1 each");
+        fprintf(outputFile, "SLOT CAPACITY: %s\n", capacity);
+    }
+    if (timeLimit > 0.0)
+        fprintf(outputFile, "TIME LIMIT: %g SECONDS\n", timeLimit);
+    if (targetCost >= 0)
+        fprintf(outputFile, "TARGET COST: %d\n", targetCost);
+    if (warmName != NULL)
+        fprintf(outputFile, "WARM START: %s\n", warmName);
+    if (diffName != NULL)
+        fprintf(outputFile, "CONSTRAINT DIFF: %s\n", diffName);
+    fprintf(outputFile, "SEED: %llu\n", (unsigned long long)seed);
+    fprintf(outputFile, "LOG LEVEL: %d\n", logLevel);
+    fprintf(outputFile, "----------------------------------------------\n");
+
+    ConstraintGraph graph;
+    int numberofvariables = loadConstraints(inputName, &graph);
+    if (diffName != NULL)
+    {
+        numberofvariables = applyConstraintDiff(diffName, &graph);
+    }
+    setSoftKinds(&graph, softKinds);
+    if (sizesName != NULL && !readExamSizes(sizesName, &graph))
+    {
+        fprintf(stderr, "Memory allocation failed.\n");
+        fclose(outputFile);
+        freeConstraintGraph(&graph);
+        return 1;
+    }
+    if (capacity != NULL && !setCapacities(&graph, capacity))
+    {
+        fprintf(stderr, "Invalid value for --capacity: %s\n", capacity);
+        fclose(outputFile);
+        freeConstraintGraph(&graph);
+        return 1;
+    }
+    if (!initSlotTables(&graph, numberofvalues))
+    {
+        fprintf(stderr, "Memory allocation failed.\n");
+        fclose(outputFile);
+        freeConstraintGraph(&graph);
+        return 1;
+    }
+
+    RestartPool pool;
+    pool.graph = &graph;
+    pool.strategy = strategy;
+    pool.params.maxTries = maxTries;
+    pool.params.maxChanges = maxChanges;
+    pool.params.p = p;
+    pool.params.tabuSize = tabuSize;
+    pool.params.tabuTenure = findTenure(tenureName);
+    pool.params.temperature = temperature;
+    pool.params.coolingRate = coolingRate;
+    pool.params.cooling = findCooling(coolingName);
+    pool.params.init = findInit(initName);
+    pool.params.logLevel = logLevel;
+    pool.params.deadline = deadline;
+    pool.params.targetCost = targetCost;
+    pool.params.start = NULL;
+    pool.params.startEveryTry = 0;
+    pool.params.stopAtSolution = firstSolutionWins;
+    pool.numberofvariables = numberofvariables;
+    pool.numberofvalues = numberofvalues;
+    pool.PrecedureRestarts = PrecedureRestarts;
+    pool.firstSolutionWins = firstSolutionWins;
+    if (minDays)
+    {
+        // An attempt only has to show that the days are enough...its first run that does ends it
+        pool.firstSolutionWins = 1;
+        pool.params.stopAtSolution = 1;
+        if (pool.params.targetCost < 0)
+            pool.params.targetCost = 0;
+    }
+    pool.traceFile = NULL;
+    if (traceName != NULL)
+    {
+        pool.traceFile = fopen(traceName, "wb");
+        if (pool.traceFile == NULL)
+        {
+            perror(traceName);
+            fclose(outputFile);
+            freeConstraintGraph(&graph);
+            return 1;
+        }
+        fwrite("MCTRACE1", 1, 8, pool.traceFile);
+    }
+    pthread_mutex_init(&pool.traceLock, NULL);
+    pool.seed = seed;
+    pool.nextRun = 0;
+    atomic_init(&pool.solved, 0);
+    pthread_mutex_init(&pool.lock, NULL);
+    pool.results = calloc(PrecedureRestarts, sizeof(RunResult));
+
+    // With a budget or a --schedule the best assignment is the answer, so it is kept and written out
+    int keepAssignment = (timeLimit > 0.0 || targetCost >= 0 || scheduleName != NULL || minDays || warmName != NULL);
+    pool.bestXvalue = NULL;
+    pool.bestCollisions = INT_MAX;
+    pool.bestPenalty = INT_MAX;
+    if (keepAssignment)
+    {
+        pool.bestXvalue = malloc(sizeof(int) * numberofvariables);
+    }
+    if (pool.results == NULL || (keepAssignment && pool.bestXvalue == NULL))
+    {
+        free(pool.results);
+        free(pool.bestXvalue);
+        fprintf(stderr, "Memory allocation failed.\n");
+        fclose(outputFile);
+        freeConstraintGraph(&graph);
+        return 1;
+    }
+
+    // Re-solve...every try starts from the previous timetable and stops once it has no conflicts again,
+    // so only the exams in conflict (new ones, or ones a new constraint hits) move
+    int *warm = NULL;
+    int warmPlaced = 0;
+    if (warmName != NULL)
+    {
+        warm = malloc(sizeof(int) * numberofvariables);
+        if (warm == NULL)
+        {
+            free(pool.results);
+            free(pool.bestXvalue);
+            fprintf(stderr, "Memory allocation failed.\n");
+            fclose(outputFile);
+            freeConstraintGraph(&graph);
+            return 1;
+        }
+        warmPlaced = readSchedule(warmName, &graph, warm);
+        pool.params.start = warm;
+        pool.params.startEveryTry = 1;
+        if (pool.params.targetCost < 0)
+            pool.params.targetCost = 0;
+    }
+
+    // Wall time of all runs together...run times are CPU times of their own thread
+    struct timespec wallStart, wallEnd;
+    clock_gettime(CLOCK_MONOTONIC, &wallStart);
+
+    if (threads == 0)
+    {
+        threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (threads < 1)
+    {
+        threads = 1;
+    }
+
+    // Normal runs, or attempts at fewer and fewer days until they fail
+    int found = 0;
+    if (minDays)
+    {
+        found = findMinDays(&pool, &graph, portfolio, portfolioCount, threads, days, outputFile);
+        days = (found > 0) ? found : days;
+    }
+    if (found < 0 || (!minDays && !runRestarts(&pool, portfolio, portfolioCount, threads)))
+    {
+        fprintf(stderr, "Memory allocation failed.\n");
+        free(pool.results);
+        free(pool.bestXvalue);
+        fclose(outputFile);
+        freeConstraintGraph(&graph);
+        return 1;
+    }
+    if (minDays)
+    {
+        fprintf(outputFile, "----------------------------------------------\n");
+        if (found == 0)
+            fprintf(outputFile, "NO NUMBER OF DAYS UP TO %d REACHED COST %d\n", days, pool.params.targetCost);
+        fprintf(outputFile, "NUMBER OF DAYS: %d\n", days);
+        fprintf(outputFile, "----------------------------------------------\n");
+    }
+    clock_gettime(CLOCK_MONOTONIC, &wallEnd);
+    double wallTime = (double)(wallEnd.tv_sec - wallStart.tv_sec) + (double)(wallEnd.tv_nsec - wallStart.tv_nsec) / 1e9;
+    fprintf(outputFile, "RUN RESULTS:\n");
+    fprintf(outputFile, "----------------------------------------------\n");
+    pthread_mutex_destroy(&pool.lock);
+    pthread_mutex_destroy(&pool.traceLock);
+    if (pool.traceFile != NULL)
+    {
+        fclose(pool.traceFile);
+    }
+
+    int SolutionsRate = 0;
+    int CompletedRuns = 0;
+    long long TotalMoves = 0;
+    int totalBestCollisions = 0;
+    long long totalBestPenalty = 0;
+    double TotalExecutionTime = 0.0;
+
+    for (int RestartsCounter = 0; RestartsCounter < PrecedureRestarts; RestartsCounter++)
+    {
+        RunResult *result = &pool.results[RestartsCounter];
+
+        fprintf(outputFile, "RUN %d:\n", RestartsCounter);
+        if (result->log != NULL)
+        {
+            copyLog(result->log, outputFile);
+        }
+        if (!result->done)
+        {
+            fprintf(outputFile, "CANCELLED\n");
+            fprintf(outputFile, "----------------------------------------------\n");
+            continue;
+        }
+
+        fprintf(outputFile, "Execution Time: %.6f seconds\n", result->executionTime);
+        fprintf(outputFile, "Moves: %lld\n", result->moves);
+        fprintf(outputFile, "Best Collisions: %d\n", result->bestCollisions);
+        fprintf(outputFile, "Best Penalty: %d\n", result->bestPenalty);
+        if (result->timedOut)
+            fprintf(outputFile, "Time Limit Reached\n");
+        fprintf(outputFile, "----------------------------------------------\n");
+
+        if (result->bestCollisions == 0)
+        {
+            SolutionsRate++;
+        }
+
+        CompletedRuns++;
+        TotalMoves += result->moves;
+        totalBestCollisions += result->bestCollisions;
+        totalBestPenalty += result->bestPenalty;
+        TotalExecutionTime += result->executionTime;
+    }
+    free(pool.results);
+
+    // Averages over the runs that were not cancelled
+    if (CompletedRuns == 0)
+    {
+        CompletedRuns = 1;
+    }
+    double AverageMoves = (double)TotalMoves / CompletedRuns;
+    double AverageBestCollisions = (double)totalBestCollisions / CompletedRuns;
+    double AverageBestPenalty = (double)totalBestPenalty / CompletedRuns;
+    double avgExecutionTime = TotalExecutionTime / CompletedRuns;
+
+    // Print statistics
+    fprintf(outputFile, "\nSUMMARY:\n");
+    fprintf(outputFile, "----------------------------------------------\n");
+    fprintf(outputFile, "SOLUTIONS RATE: %d/%d\n", SolutionsRate, PrecedureRestarts);
+    fprintf(outputFile, "AVERAGE MOVES: %.2f\n", AverageMoves);
+    fprintf(outputFile, "AVERAGE BEST COLLISIONS: %.2f\n", AverageBestCollisions);
+    fprintf(outputFile, "AVERAGE BEST PENALTY: %.2f\n", AverageBestPenalty);
+    fprintf(outputFile, "AVERAGE EXECUTION TIME: %.6f SECONDS\n", avgExecutionTime);
+    fprintf(outputFile, "WALL TIME: %.6f SECONDS\n", wallTime);
+    fprintf(outputFile, "MOVES PER SECOND: %.0f\n", (wallTime > 0.0) ? TotalMoves / wallTime : 0.0);
+    if (warm != NULL && pool.bestCollisions != INT_MAX)
+    {
+        int kept = 0;
+        for (int k = 0; k < numberofvariables; k++)
+        {
+            kept += (warm[k] >= 0 && pool.bestXvalue[k] == warm[k]);
+        }
+        fprintf(outputFile, "EXAMS KEPT IN THEIR SLOT: %d/%d (%d NOT PLACED BY THE WARM START)\n", kept, warmPlaced, numberofvariables - warmPlaced);
+    }
+    fprintf(outputFile, "----------------------------------------------\n");
+
+    // Anytime result...the best assignment any run reached within the budget
+    if ((timeLimit > 0.0 || targetCost >= 0) && pool.bestCollisions != INT_MAX)
+    {
+        fprintf(outputFile, "\nBEST ASSIGNMENT (Collisions = %d, Penalty = %d):\n", pool.bestCollisions, pool.bestPenalty);
+        for (int k = 0; k < numberofvariables; k++)
+        {
+            fprintf(outputFile, "X%d = %d\n", k, pool.bestXvalue[k]);
+        }
+        fprintf(outputFile, "----------------------------------------------\n");
+    }
+
+    int written = 1;
+    if (scheduleName != NULL)
+    {
+        if (pool.bestCollisions == INT_MAX)
+        {
+            fprintf(stderr, "No run finished, %s was not written.\n", scheduleName);
+            written = 0;
+        }
+        else
+        {
+            written = writeSchedule(scheduleName, pool.bestXvalue, &graph, pool.bestCollisions, pool.bestPenalty);
+        }
+    }
+    free(pool.bestXvalue);
+    free(warm);
+
+    fclose(outputFile);
+    freeConstraintGraph(&graph);
+    printf("----------------------------------------------\n");
+    printf("RESULTS SAVED TO %s\n", outputName);
+    if (scheduleName != NULL && written)
+        printf("SCHEDULE SAVED TO %s\n", scheduleName);
+
+    return written ? 0 : 1;
+}
+
+void printUsage(const char *program)
+{
+    printf("Usage: %s [options]\n", program);
+    printf("       %s convert INPUT.csv OUTPUT.bin\n", program);
+    printf("       %s bench [options]\n", program);
+    printf("Parameters that are not given are asked for on the terminal.\n");
+    printf("  -S, --strategy NAME       minconflicts (default), walk, tabu, anneal or breakout\n");
+    printf("  -t, --tries N             tries (random restarts) per run\n");
+    printf("  -c, --changes N           changes per try (maxChanges)\n");
+    printf("  -d, --days N              number of days (%d timeslots each)\n", PERIODS_PER_DAY);
+    printf("  -r, --restarts N          number of procedure restarts\n");
+    printf("  -j, --threads N           worker threads, 0 = all cores (default 0)\n");
+    printf("  -f, --first-solution      stop all runs once one finds a solution (or reaches --target-cost)\n");
+    printf("  -s, --seed N              random seed (default: the clock)\n");
+    printf("  -i, --input FILE          constraints matrix, edge list or binary graph file (default BetterCSVview.csv)\n");
+    printf("  -o, --output FILE         results file (default FIRST.txt ... FIFTH.txt by strategy)\n");
+    printf("  -v, --log-level N         0 = summary only (default), 1 = every try, 2 = every move\n");
+    printf("  -b, --trace FILE          write every move to FILE in a compact binary format\n");
+    printf("  -p, --walk-probability P  walk: probability of a random move (default %.1f)\n", WALK_PROBABILITY);
+    printf("  -T, --tabu-size N         tabu: moves a value that was left stays tabu (default %d)\n", TABU_SIZE);
+    printf("  -R, --tabu-tenure MODE    tabu: fixed (default), dynamic (random plus conflicts) or reactive (grows when stuck)\n");
+    printf("  -K, --temperature T       anneal: starting temperature (default %g)\n", ANNEAL_TEMPERATURE);
+    printf("  -a, --cooling-rate A      anneal: temperature factor per move (default: the one that reaches %g at --changes)\n", ANNEAL_FINAL);
+    printf("  -m, --cooling MODE        anneal: geometric (default), adaptive (keeps moves accepted) or reheating (resets when stuck)\n");
+    printf("  -g, --init MODE           start of every try: random (default, dsatur with --warm-start), dsatur (most constrained exam first) or greedy (random order)\n");
+    printf("  -k, --soft KINDS          constraint types that are weighted penalties, e.g. 2,3 or none (default %s)\n", SOFT_KINDS);
+    printf("  -z, --sizes FILE          students of every exam, one exam,size line each (default 1 each, also for unlisted exams)\n");
+    printf("  -C, --capacity LIST       students a slot holds, one value or one per slot, the last one repeats\n");
+    printf("  -L, --time-limit SECONDS  stop every run at this wall time from the start and write the best assignment\n");
+    printf("  -G, --target-cost N       stop a run once its cost is at most N and write the best assignment\n");
+    printf("  -w, --schedule FILE       write the best assignment as exam,day,period rows, or JSON if FILE ends in .json\n");
+    printf("  -D, --min-days            find the fewest days up to --days at which a run reaches cost 0 (or --target-cost),\n");
+    printf("                            bisecting, every attempt starting from the schedule of the last days that worked\n");
+    printf("  -W, --warm-start FILE     start every try from a --schedule FILE and stop once it has no conflicts (or reaches\n");
+    printf("                            --target-cost)...exams it does not place go where --init puts them (default dsatur)\n");
+    printf("  -X, --diff FILE           change the constraints first, +i,j,kind[,weight] adds one and -i,j,kind removes one\n");
+    printf("  -P, --portfolio LIST      run the strategies of LIST (e.g. %s) together on every run, a worker per thread\n", PORTFOLIO);
+    printf("                            and at least one per strategy, sharing their best assignments...output PORTFOLIO.txt,\n");
+    printf("                            --strategy is ignored\n");
+}
+
+// Parse a numeric option...anything that is not a whole number >= minimum is an error
+int parseInt(const char *text, const char *name, int minimum)
+{
+    char *end;
+    long value = strtol(text, &end, 10);
+    if (*text == '\0' || *end != '\0' || value < minimum || value > INT_MAX)
+    {
+        fprintf(stderr, "Invalid value for --%s: %s\n", name, text);
+        exit(1);
+    }
+    return (int)value;
+}
+
+// Parse a real option...anything that is not a number from minimum to maximum is an error
+double parseDouble(const char *text, const char *name, double minimum, double maximum)
+{
+    char *end;
+    double value = strtod(text, &end);
+    if (*text == '\0' || *end != '\0' || !(value >= minimum && value <= maximum))
+    {
+        fprintf(stderr, "Invalid value for --%s: %s\n", name, text);
+        exit(1);
+    }
+    return value;
+}
+
+// Ask for a parameter that was not given on the command line until it is valid
+int readParameter(const char *prompt, int minimum)
+{
+    int value;
+    while (1)
+    {
+        printf("%s", prompt);
+        int status = scanf("%d", &value);
+        if (status == EOF)
+        {
+            fprintf(stderr, "\nMissing input.\n");
+            exit(1);
+        }
+        if (status == 1 && value >= minimum)
+        {
+            return value;
+        }
+        printf("Invalid input.\n");
+        if (status == 0)
+        {
+            scanf("%*s"); // Skip the word that is not a number
+        }
+    }
+}
+
+// Thread pool worker...takes runs until all PrecedureRestarts are handed out
+void *restartWorker(void *arg)
+{
+    RestartPool *pool = arg;
+    atomic_int *stop = pool->firstSolutionWins ? &pool->solved : NULL;
+
+    // Search state, strategy data and trace buffer of this thread
+    SearchState search;
+    search.graph = pool->graph;
+    search.params = &pool->params;
+    search.numberofvariables = pool->numberofvariables;
+    search.numberofvalues = pool->numberofvalues;
+    search.elite = NULL;
+    search.data = NULL;
+    search.Xvalue = malloc(sizeof(int) * pool->numberofvariables);
+    search.bestXvalue = (pool->bestXvalue != NULL) ? malloc(sizeof(int) * pool->numberofvariables) : NULL;
+    TraceWriter *trace = (pool->traceFile != NULL) ? malloc(sizeof(TraceWriter)) : NULL;
+    if (search.Xvalue == NULL || (pool->bestXvalue != NULL && search.bestXvalue == NULL) || (pool->traceFile != NULL && trace == NULL) ||
+        (pool->strategy->start != NULL && !pool->strategy->start(&search)))
+    {
+        fprintf(stderr, "Memory allocation failed.\n");
+        free(search.Xvalue);
+        free(search.bestXvalue);
+        free(trace);
+        return NULL;
+    }
+    if (trace != NULL)
+    {
+        trace->file = pool->traceFile;
+        trace->lock = &pool->traceLock;
+        trace->count = 0;
+    }
+
+    while (1)
+    {
+        pthread_mutex_lock(&pool->lock);
+        int run = pool->nextRun++;
+        pthread_mutex_unlock(&pool->lock);
+
+        if (run >= pool->PrecedureRestarts)
+            break;
+        if (stop != NULL && atomic_load(stop))
+            continue; // Another run already found a solution
+        if (pool->params.deadline > 0.0 && wallClock() >= pool->params.deadline)
+            continue; // Out of time before the run started
+
+        // Only the summary needs no per-run output
+        RunResult *result = &pool->results[run];
+        if (pool->params.logLevel > LOG_SUMMARY)
+        {
+            result->log = tmpfile();
+            if (result->log == NULL)
+            {
+                fprintf(stderr, "ERROR OPENING TEMPORARY FILE.\n");
+                continue;
+            }
+        }
+        if (trace != NULL)
+        {
+            trace->run = run;
+        }
+
+        rngSeed(&search.rng, pool->seed + (uint64_t)run);
+        search.moves = 0;
+        search.bestCost = INT_MAX;
+        search.bestPenalty = INT_MAX;
+        search.timedOut = 0;
+
+        // Measure execution time of this thread only
+        struct timespec start, end;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+        result->done = solve(pool->strategy, &search, result->log, stop, trace);
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &end);
+        result->executionTime = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+        result->moves = search.moves;
+        result->bestCollisions = search.bestCost;
+        result->bestPenalty = search.bestPenalty;
+        result->timedOut = search.timedOut;
+        if (search.bestXvalue != NULL)
+        {
+            keepBest(pool, search.bestXvalue, search.bestCost, search.bestPenalty);
+        }
+
+        if (stop != NULL && (result->bestCollisions == 0 || result->bestCollisions <= pool->params.targetCost))
+        {
+            atomic_store(stop, 1);
+        }
+    }
+
+    if (trace != NULL)
+    {
+        flushTrace(trace);
+        free(trace);
+    }
+    if (pool->strategy->finish != NULL)
+    {
+        pool->strategy->finish(&search);
+    }
+    free(search.Xvalue);
+    free(search.bestXvalue);
+    return NULL;
+}
+
+// Every run of the pool...a portfolio, or a thread pool in which every thread takes the next run until all are done
+// threads is at least 1. Returns 0 if memory ran out
+int runRestarts(RestartPool *pool, const Strategy **portfolio, int portfolioCount, int threads)
+{
+    // Portfolio...one run at a time, every thread works on it, and every strategy of the list runs even with fewer threads
+    if (portfolioCount > 0)
+    {
+        return runPortfolio(pool, portfolio, portfolioCount, (threads > portfolioCount) ? threads : portfolioCount, threads);
+    }
+
+    if (threads > pool->PrecedureRestarts)
+    {
+        threads = pool->PrecedureRestarts;
+    }
+    pthread_t *workers = malloc(sizeof(pthread_t) * threads);
+    int started = 0;
+    while (workers != NULL && started < threads && pthread_create(&workers[started], NULL, restartWorker, pool) == 0)
+    {
+        started++;
+    }
+    if (started == 0)
+    {
+        restartWorker(pool); // No threads available, run everything here
+    }
+    for (int t = 0; t < started; t++)
+    {
+        pthread_join(workers[t], NULL);
+    }
+    free(workers);
+    return 1;
+}
+
+// --min-days...bisects the number of days between 1 and maxDays, every attempt running all the runs at one day count
+// An attempt succeeds when a run reaches the target cost. Each one starts from the best schedule of the fewest days
+// that succeeded so far, the exams of the days that are gone on random slots
+// Leaves the runs, the best assignment and the slot tables of that day count in pool and graph...of maxDays if even it
+// failed. Returns the fewest days that succeeded, 0 if none did, -1 if memory ran out
+int findMinDays(RestartPool *pool, ConstraintGraph *graph, const Strategy **portfolio, int portfolioCount, int threads, int maxDays, FILE *outputFile)
+{
+    int numberofvariables = pool->numberofvariables;
+    RunResult *kept = calloc(pool->PrecedureRestarts, sizeof(RunResult)); // Runs of keptDays
+    int *best = malloc(sizeof(int) * numberofvariables);                  // Best assignment of keptDays
+    int *start = malloc(sizeof(int) * numberofvariables);
+    if (kept == NULL || best == NULL || start == NULL)
+    {
+        free(kept);
+        free(best);
+        free(start);
+        return -1;
+    }
+    int keptDays = 0, keptCollisions = INT_MAX, keptPenalty = INT_MAX, feasible = 0;
+    int low = 1, high = maxDays; // Day counts left to try...maxDays first
+    int days = maxDays;
+    int status = 1;
+
+    fprintf(outputFile, "ATTEMPTS:\n");
+    while (low <= high)
+    {
+        if (pool->params.deadline > 0.0 && wallClock() >= pool->params.deadline)
+            break;
+
+        int numberofvalues = days * PERIODS_PER_DAY;
+        if (!initSlotTables(graph, numberofvalues))
+        {
+            status = -1;
+            break;
+        }
+        pool->numberofvalues = numberofvalues;
+        pool->nextRun = 0;
+        atomic_store(&pool->solved, 0);
+        pool->bestCollisions = INT_MAX;
+        pool->bestPenalty = INT_MAX;
+        pool->params.start = NULL;
+        if (feasible)
+        {
+            for (int x = 0; x < numberofvariables; x++)
+                start[x] = (best[x] < numberofvalues) ? best[x] : -1;
+            pool->params.start = start;
+        }
+
+        double attemptStart = wallClock();
+        if (!runRestarts(pool, portfolio, portfolioCount, threads))
+        {
+            status = -1;
+            break;
+        }
+        int success = (pool->bestCollisions <= pool->params.targetCost);
+        fprintf(outputFile, "%d DAYS: %s (Best Collisions = %d, %.3f seconds)\n", days, success ? "REACHED" : "NOT REACHED",
+                pool->bestCollisions, wallClock() - attemptStart);
+        fflush(outputFile);
+
+        // The runs of maxDays are kept even if they failed, to be reported
+        if (success || keptDays == 0)
+        {
+            RunResult *swap = kept;
+            kept = pool->results;
+            pool->results = swap;
+            keptDays = days;
+            keptCollisions = pool->bestCollisions;
+            keptPenalty = pool->bestPenalty;
+            if (keptCollisions != INT_MAX)
+                memcpy(best, pool->bestXvalue, sizeof(int) * numberofvariables);
+        }
+        discardResults(pool->results, pool->PrecedureRestarts);
+        if (!success && !feasible)
+            break; // Not even maxDays
+        feasible = 1;
+
+        if (success)
+            high = days - 1;
+        else
+            low = days + 1;
+        days = low + (high - low) / 2;
+    }
+
+    // Back to the day count that is reported
+    RunResult *unused = pool->results;
+    pool->results = kept;
+    free(unused);
+    pool->params.start = NULL;
+    pool->numberofvalues = keptDays * PERIODS_PER_DAY;
+    pool->bestCollisions = keptCollisions;
+    pool->bestPenalty = keptPenalty;
+    if (keptCollisions != INT_MAX)
+        memcpy(pool->bestXvalue, best, sizeof(int) * numberofvariables);
+    free(best);
+    free(start);
+    if (status < 0 || (keptDays > 0 && !initSlotTables(graph, keptDays * PERIODS_PER_DAY)))
+        return -1;
+    return (feasible && keptCollisions <= pool->params.targetCost) ? keptDays : 0;
+}
+
+// Close the logs of the runs and forget them
+void discardResults(RunResult *results, int count)
+{
+    for (int k = 0; k < count; k++)
+    {
+        if (results[k].log != NULL)
+            fclose(results[k].log);
+    }
+    memset(results, 0, sizeof(RunResult) * count);
+}
+
+// Portfolio runs...the workers search every run together, worker w with strategy w of the list (round robin),
+// and start their later tries from the best assignments the others published
+// Workers past threadCount run one after another on this thread. Returns 0 if memory ran out before the first run
+int runPortfolio(RestartPool *pool, const Strategy **portfolio, int portfolioCount, int workers, int threadCount)
+{
+    PortfolioWorker *worker = calloc(workers, sizeof(PortfolioWorker));
+    pthread_t *threads = malloc(sizeof(pthread_t) * workers);
+    int *started = calloc(workers, sizeof(int));
+    ElitePool elite;
+    int ready = 0;
+    atomic_int stop;
+
+    if (worker != NULL && threads != NULL && started != NULL && initElitePool(&elite, pool->numberofvariables))
+    {
+        for (ready = 0; ready < workers; ready++)
+        {
+            PortfolioWorker *w = &worker[ready];
+            w->pool = pool;
+            w->strategy = portfolio[ready % portfolioCount];
+            w->index = ready;
+            w->workers = workers;
+            w->stop = &stop;
+            w->search.graph = pool->graph;
+            w->search.params = &pool->params;
+            w->search.numberofvariables = pool->numberofvariables;
+            w->search.numberofvalues = pool->numberofvalues;
+            w->search.elite = &elite;
+            w->search.data = NULL;
+            w->search.Xvalue = malloc(sizeof(int) * pool->numberofvariables);
+            w->search.bestXvalue = malloc(sizeof(int) * pool->numberofvariables);
+            w->trace = (pool->traceFile != NULL) ? malloc(sizeof(TraceWriter)) : NULL;
+            if (w->search.Xvalue == NULL || w->search.bestXvalue == NULL || (pool->traceFile != NULL && w->trace == NULL) ||
+                (w->strategy->start != NULL && !w->strategy->start(&w->search)))
+            {
+                free(w->search.Xvalue);
+                free(w->search.bestXvalue);
+                free(w->trace);
+                break;
+            }
+            if (w->trace != NULL)
+            {
+                w->trace->file = pool->traceFile;
+                w->trace->lock = &pool->traceLock;
+                w->trace->count = 0;
+            }
+        }
+        if (ready < workers)
+        {
+            freeElitePool(&elite);
+        }
+    }
+    if (ready < workers)
+    {
+        for (int k = 0; k < ready; k++)
+        {
+            if (worker[k].strategy->finish != NULL)
+                worker[k].strategy->finish(&worker[k].search);
+            free(worker[k].search.Xvalue);
+            free(worker[k].search.bestXvalue);
+            free(worker[k].trace);
+        }
+        free(worker);
+        free(threads);
+        free(started);
+        return 0;
+    }
+
+    for (int run = 0; run < pool->PrecedureRestarts; run++)
+    {
+        if (pool->firstSolutionWins && atomic_load(&pool->solved))
+            break; // The runs left stay cancelled
+        if (pool->params.deadline > 0.0 && wallClock() >= pool->params.deadline)
+            break;
+
+        clearElitePool(&elite);
+        atomic_init(&stop, 0);
+        for (int k = 0; k < workers; k++)
+        {
+            worker[k].run = run;
+            worker[k].log = NULL;
+            if (pool->params.logLevel > LOG_SUMMARY)
+            {
+                worker[k].log = tmpfile();
+            }
+        }
+
+        // Worker 0 runs on this thread, and so does any worker past threadCount or that could not get one
+        for (int k = 1; k < workers; k++)
+        {
+            started[k] = (k < threadCount && pthread_create(&threads[k], NULL, portfolioWorker, &worker[k]) == 0);
+        }
+        portfolioWorker(&worker[0]);
+        for (int k = 1; k < workers; k++)
+        {
+            if (started[k])
+                pthread_join(threads[k], NULL);
+            else
+                portfolioWorker(&worker[k]);
+        }
+
+        // The run is as good as its best worker...moves and times are summed over the workers
+        RunResult *result = &pool->results[run];
+        result->done = 1;
+        result->moves = 0;
+        result->bestCollisions = INT_MAX;
+        result->bestPenalty = INT_MAX;
+        result->timedOut = 0;
+        result->executionTime = 0.0;
+        int best = 0;
+        for (int k = 0; k < workers; k++)
+        {
+            SearchState *search = &worker[k].search;
+            result->done &= worker[k].done;
+            result->timedOut |= search->timedOut;
+            result->moves += search->moves;
+            result->executionTime += worker[k].executionTime;
+            if (search->bestCost < result->bestCollisions || (search->bestCost == result->bestCollisions && search->bestPenalty < result->bestPenalty))
+            {
+                result->bestCollisions = search->bestCost;
+                result->bestPenalty = search->bestPenalty;
+                best = k;
+            }
+        }
+        if (pool->bestXvalue != NULL && result->bestCollisions != INT_MAX)
+        {
+            keepBest(pool, worker[best].search.bestXvalue, result->bestCollisions, result->bestPenalty);
+        }
+        if ((result->bestCollisions == 0 && (result->bestPenalty == 0 || pool->params.stopAtSolution)) || result->bestCollisions <= pool->params.targetCost)
+        {
+            result->done = 1; // The other workers were stopped, not cancelled
+        }
+        if (pool->params.logLevel > LOG_SUMMARY)
+        {
+            result->log = tmpfile();
+            for (int k = 0; k < workers; k++)
+            {
+                if (worker[k].log == NULL)
+                    continue;
+                if (result->log != NULL)
+                {
+                    fprintf(result->log, "WORKER %d (%s):\n", k, worker[k].strategy->name);
+                    copyLog(worker[k].log, result->log);
+                }
+                else
+                {
+                    fclose(worker[k].log);
+                }
+            }
+        }
+        if (pool->firstSolutionWins && (result->bestCollisions == 0 || result->bestCollisions <= pool->params.targetCost))
+        {
+            atomic_store(&pool->solved, 1);
+        }
+    }
+
+    for (int k = 0; k < workers; k++)
+    {
+        if (worker[k].trace != NULL)
+        {
+            flushTrace(worker[k].trace);
+            free(worker[k].trace);
+        }
+        if (worker[k].strategy->finish != NULL)
+            worker[k].strategy->finish(&worker[k].search);
+        free(worker[k].search.Xvalue);
+        free(worker[k].search.bestXvalue);
+    }
+    freeElitePool(&elite);
+    free(worker);
+    free(threads);
+    free(started);
+    return 1;
+}
+
+// One worker of a portfolio run...stops the others when it finds a solution
+void *portfolioWorker(void *arg)
+{
+    PortfolioWorker *worker = arg;
+    RestartPool *pool = worker->pool;
+    SearchState *search = &worker->search;
+
+    worker->done = 0;
+    search->moves = 0;
+    search->bestCost = INT_MAX;
+    search->bestPenalty = INT_MAX;
+    search->timedOut = 0;
+    search->published = 1;
+    worker->executionTime = 0.0;
+    if (pool->params.logLevel > LOG_SUMMARY && worker->log == NULL)
+    {
+        fprintf(stderr, "ERROR OPENING TEMPORARY FILE.\n");
+        return NULL;
+    }
+    if (worker->trace != NULL)
+    {
+        worker->trace->run = worker->run;
+    }
+    rngSeed(&search->rng, pool->seed + (uint64_t)worker->run * (uint64_t)worker->workers + (uint64_t)worker->index);
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+    worker->done = solve(worker->strategy, search, worker->log, worker->stop, worker->trace);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &end);
+    worker->executionTime = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+    if ((search->bestCost == 0 && (search->bestPenalty == 0 || pool->params.stopAtSolution)) || search->bestCost <= pool->params.targetCost)
+    {
+        atomic_store(worker->stop, 1);
+    }
+    return NULL;
+}
+
+// Keep Xvalue if it is the best assignment of all runs so far
+void keepBest(RestartPool *pool, const int *Xvalue, int collisions, int penalty)
+{
+    pthread_mutex_lock(&pool->lock);
+    if (collisions < pool->bestCollisions || (collisions == pool->bestCollisions && penalty < pool->bestPenalty))
+    {
+        memcpy(pool->bestXvalue, Xvalue, sizeof(int) * pool->numberofvariables);
+        pool->bestCollisions = collisions;
+        pool->bestPenalty = penalty;
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+// Append the output of a run to the output file
+void copyLog(FILE *log, FILE *outputFile)
+{
+    char buffer[4096];
+    size_t length;
+
+    rewind(log);
+    while ((length = fread(buffer, 1, sizeof(buffer), log)) > 0)
+    {
+        fwrite(buffer, 1, length, outputFile);
+    }
+    fclose(log);
+}
@@ -0,0 +1,724 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "csp.h"
+
+#define TABU_DYNAMIC_FACTOR 0.6 // Dynamic tenure per conflicted variable
+#define TABU_REACTIVE_WINDOW 100 // Moves without a new best before the reactive tenure grows
+#define ANNEAL_WINDOW 100         // Moves between two adjustments of the adaptive temperature
+#define ANNEAL_ACCEPTANCE 0.2     // Share of accepted moves the adaptive temperature aims at
+#define ANNEAL_REHEAT_AFTER 5000  // Moves without a new best before the temperature is reset
+
+// Tabu status of every (variable, value)...checked in O(1) whatever the tenure
+typedef struct
+{
+    int *expiry;     // expiry[x * numberofvalues + value] = first iteration at which X[x] = value is allowed again
+    int iteration;   // Moves made in this try
+    int tenure;      // Tenure of the next move when it is reactive
+    int bestCost;    // Lowest cost of the try, for the reactive tenure
+    int bestPenalty; // Lowest penalty at bestCost
+    int stagnation;  // Moves since bestCost last improved
+} TabuState;
+
+// Annealing state of a try
+typedef struct
+{
+    double temperature;
+    double coolingRate;   // --cooling-rate, or the rate that takes a try from temperature to ANNEAL_FINAL
+    double windowCooling; // coolingRate ^ ANNEAL_WINDOW, for the adaptive schedule
+    int proposed;         // Moves proposed in the current window
+    int accepted;         // ... and accepted
+    int bestCost;         // Lowest (cost, penalty) of the try, for reheating
+    int bestPenalty;
+    int stagnation;       // Moves since the best last improved
+} AnnealState;
+
+// Breakout state of a thread...the bonus and guide arrays are lent to the conflict table of every try
+typedef struct
+{
+    int *bonus;    // Extra weight of every hard constraint, on both of its copies
+    int *guides;   // Extra weight of every (variable, value), see ConflictTable
+    int *combined; // Conflicts plus guides of the variable being moved
+} BreakoutState;
+
+// Functions signature
+int chooseBestValue(SearchState *search, int x, int *newCost, int *newPenalty);
+int chooseWalkValue(SearchState *search, int x, int *newCost, int *newPenalty);
+int startTabu(SearchState *search);
+void restartTabu(SearchState *search);
+int chooseTabuValue(SearchState *search, int x, int *newCost, int *newPenalty);
+void movedTabu(SearchState *search, int x, int previous);
+void finishTabu(SearchState *search);
+int startAnneal(SearchState *search);
+void restartAnneal(SearchState *search);
+int chooseAnnealValue(SearchState *search, int x, int *newCost, int *newPenalty);
+void finishAnneal(SearchState *search);
+int startBreakout(SearchState *search);
+void restartBreakout(SearchState *search);
+int chooseBreakoutValue(SearchState *search, int x, int *newCost, int *newPenalty);
+void finishBreakout(SearchState *search);
+
+const Strategy minConflictsStrategy = {"minconflicts", "FIRST.txt", NULL, NULL, chooseBestValue, NULL, NULL};
+const Strategy walkStrategy = {"walk", "SECOND.txt", NULL, NULL, chooseWalkValue, NULL, NULL};
+const Strategy tabuStrategy = {"tabu", "THIRD.txt", startTabu, restartTabu, chooseTabuValue, movedTabu, finishTabu};
+const Strategy annealStrategy = {"anneal", "FOURTH.txt", startAnneal, restartAnneal, chooseAnnealValue, NULL, finishAnneal};
+const Strategy breakoutStrategy = {"breakout", "FIFTH.txt", startBreakout, restartBreakout, chooseBreakoutValue, NULL, finishBreakout};
+
+static const Strategy *const strategies[] = {&minConflictsStrategy, &walkStrategy, &tabuStrategy, &annealStrategy, &breakoutStrategy};
+
+// Strategy called name...NULL if there is none
+const Strategy *findStrategy(const char *name)
+{
+    for (size_t i = 0; i < sizeof(strategies) / sizeof(strategies[0]); i++)
+    {
+        if (strcmp(strategies[i]->name, name) == 0)
+        {
+            return strategies[i];
+        }
+    }
+    return NULL;
+}
+
+static const char *const tenureNames[] = {"fixed", "dynamic", "reactive"};       // In TENURE_ order
+static const char *const coolingNames[] = {"geometric", "adaptive", "reheating"}; // In COOLING_ order
+static const char *const initNames[] = {"random", "dsatur", "greedy"};            // In INIT_ order
+
+// TENURE_ value of a --tabu-tenure name...-1 if there is none
+int findTenure(const char *name)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        if (strcmp(tenureNames[i], name) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// COOLING_ value of a --cooling name...-1 if there is none
+int findCooling(const char *name)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        if (strcmp(coolingNames[i], name) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// INIT_ value of an --init name...-1 if there is none
+int findInit(const char *name)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        if (strcmp(initNames[i], name) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// --tabu-tenure, --cooling and --init names of TENURE_, COOLING_ and INIT_ values
+const char *nameOfTenure(int tenure)
+{
+    return (tenure >= 0 && tenure < 3) ? tenureNames[tenure] : "?";
+}
+
+const char *nameOfCooling(int cooling)
+{
+    return (cooling >= 0 && cooling < 3) ? coolingNames[cooling] : "?";
+}
+
+const char *nameOfInit(int init)
+{
+    return (init >= 0 && init < 3) ? initNames[init] : "?";
+}
+
+// Seconds on the monotonic clock...wall time, unlike clock() it does not add up the CPU time of threads
+double wallClock(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+// Empty elite pool for assignments of numberofvariables...0 if memory ran out
+int initElitePool(ElitePool *pool, int numberofvariables)
+{
+    pool->numberofvariables = numberofvariables;
+    for (int k = 0; k < ELITE_SIZE; k++)
+    {
+        pool->slots[k].Xvalue = malloc(sizeof(atomic_int) * numberofvariables);
+        if (pool->slots[k].Xvalue == NULL)
+        {
+            for (int j = 0; j < k; j++)
+                free(pool->slots[j].Xvalue);
+            return 0;
+        }
+    }
+    clearElitePool(pool);
+    return 1;
+}
+
+// Forget every assignment...only while no worker is using the pool
+void clearElitePool(ElitePool *pool)
+{
+    for (int k = 0; k < ELITE_SIZE; k++)
+    {
+        atomic_init(&pool->slots[k].sequence, 0);
+        atomic_init(&pool->slots[k].cost, INT_MAX);
+        atomic_init(&pool->slots[k].penalty, INT_MAX);
+    }
+}
+
+// Put Xvalue in place of the worst elite if it is better...1 if it was stored
+// Never waits: if another worker is writing that slot the assignment is dropped
+int publishElite(ElitePool *pool, const int *Xvalue, int cost, int penalty)
+{
+    EliteSlot *worst = NULL;
+    int worstCost = -1, worstPenalty = -1;
+    for (int k = 0; k < ELITE_SIZE; k++)
+    {
+        int slotCost = atomic_load_explicit(&pool->slots[k].cost, memory_order_relaxed);
+        int slotPenalty = atomic_load_explicit(&pool->slots[k].penalty, memory_order_relaxed);
+        if (slotCost > worstCost || (slotCost == worstCost && slotPenalty > worstPenalty))
+        {
+            worst = &pool->slots[k];
+            worstCost = slotCost;
+            worstPenalty = slotPenalty;
+        }
+    }
+    if (cost > worstCost || (cost == worstCost && penalty >= worstPenalty))
+        return 0;
+
+    // Odd sequence...the slot is ours until it is even again
+    unsigned sequence = atomic_load_explicit(&worst->sequence, memory_order_relaxed);
+    if ((sequence & 1) || !atomic_compare_exchange_strong_explicit(&worst->sequence, &sequence, sequence + 1, memory_order_acquire, memory_order_relaxed))
+        return 0;
+    atomic_thread_fence(memory_order_release);
+
+    // The slot may have been improved since it was found to be the worst
+    int stored = (cost < atomic_load_explicit(&worst->cost, memory_order_relaxed) ||
+                  (cost == atomic_load_explicit(&worst->cost, memory_order_relaxed) && penalty < atomic_load_explicit(&worst->penalty, memory_order_relaxed)));
+    if (stored)
+    {
+        for (int k = 0; k < pool->numberofvariables; k++)
+            atomic_store_explicit(&worst->Xvalue[k], Xvalue[k], memory_order_relaxed);
+        atomic_store_explicit(&worst->cost, cost, memory_order_relaxed);
+        atomic_store_explicit(&worst->penalty, penalty, memory_order_relaxed);
+    }
+    atomic_store_explicit(&worst->sequence, sequence + 2, memory_order_release);
+    return stored;
+}
+
+// Copy a random elite into Xvalue...0 if the pool is empty or every slot kept changing while it was read
+int readElite(ElitePool *pool, int *Xvalue, Rng *rng)
+{
+    int first = (int)rngBounded(rng, ELITE_SIZE);
+    for (int k = 0; k < ELITE_SIZE; k++)
+    {
+        EliteSlot *slot = &pool->slots[(first + k) % ELITE_SIZE];
+        for (int attempt = 0; attempt < 4; attempt++)
+        {
+            unsigned before = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+            if (before & 1)
+                continue;
+            if (atomic_load_explicit(&slot->cost, memory_order_relaxed) == INT_MAX)
+                break; // Empty
+            for (int x = 0; x < pool->numberofvariables; x++)
+                Xvalue[x] = atomic_load_explicit(&slot->Xvalue[x], memory_order_relaxed);
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load_explicit(&slot->sequence, memory_order_relaxed) == before)
+                return 1;
+        }
+    }
+    return 0;
+}
+
+void freeElitePool(ElitePool *pool)
+{
+    for (int k = 0; k < ELITE_SIZE; k++)
+        free(pool->slots[k].Xvalue);
+}
+
+// The search engine shared by every strategy
+// Returns 0 if the run was cancelled or ran out of memory, otherwise 1
+int solve(const Strategy *strategy, SearchState *search, FILE *outputFile, atomic_int *stop, TraceWriter *trace)
+{
+    const SolverParams *params = search->params;
+    int numberofvariables = search->numberofvariables;
+    int numberofvalues = search->numberofvalues;
+    int *Xvalue = search->Xvalue;
+    ConflictTable *table = &search->table;
+
+    // Decided once...at LOG_SUMMARY the loop below formats nothing
+    int logTries = (params->logLevel >= LOG_TRY);
+    int logMoves = (params->logLevel >= LOG_MOVE);
+    search->solvedAt = 0.0;
+
+    for (int i = 0; i < params->maxTries; i++)
+    { // maxTries
+        if (logTries)
+            fprintf(outputFile, "TRY %d:\n", i);
+        // Initialize the assignment
+        // A := initial complete assignment of the variables in Problem
+        // A given start is where the first try begins (every try with startEveryTry), --init placing its -1 variables
+        // In a portfolio the other tries after the first start from an elite assignment with a few random changes
+        const int *start = (params->start != NULL && (i == 0 || params->startEveryTry)) ? params->start : NULL;
+        if (start == NULL && i > 0 && search->elite != NULL && readElite(search->elite, Xvalue, &search->rng))
+        {
+            int kicks = (int)(numberofvariables * ELITE_KICK) + 1;
+            for (int k = 0; k < kicks; k++)
+                Xvalue[rngBounded(&search->rng, numberofvariables)] = (int)rngBounded(&search->rng, numberofvalues);
+            if (logTries)
+                fprintf(outputFile, "STARTED FROM AN ELITE ASSIGNMENT\n");
+        }
+        else if (params->init == INIT_RANDOM && start != NULL)
+        {
+            for (int k = 0; k < numberofvariables; k++)
+                Xvalue[k] = (start[k] >= 0) ? start[k] : (int)rngBounded(&search->rng, numberofvalues);
+        }
+        else if (params->init == INIT_RANDOM)
+        {
+            initialize(Xvalue, numberofvariables, numberofvalues, logMoves ? outputFile : NULL, &search->rng);
+        }
+        else if (initializeGreedy(Xvalue, numberofvariables, numberofvalues, search->graph, start, params->init == INIT_DSATUR, logMoves ? outputFile : NULL, &search->rng) == NULL)
+        {
+            fprintf(stderr, "Memory allocation failed.\n");
+            return 0;
+        }
+        if (start != NULL && logTries)
+            fprintf(outputFile, "STARTED FROM A GIVEN ASSIGNMENT\n");
+        if (!initConflictTable(table, Xvalue, numberofvariables, numberofvalues, search->graph))
+        {
+            fprintf(stderr, "Memory allocation failed.\n");
+            return 0;
+        }
+        if (strategy->restart != NULL)
+            strategy->restart(search);
+
+        for (int j = 0; j < params->maxChanges; j++)
+        { //  for j:=1 to maxChanges do
+            // Another run found a solution first
+            if (stop != NULL && atomic_load_explicit(stop, memory_order_relaxed))
+            {
+                freeConflictTable(table);
+                return 0;
+            }
+
+            search->moves++;
+
+            // Calculate cost...conflicts first, then the penalty of the soft constraints
+            int currentCost = table->cost;
+            int currentPenalty = table->penalty;
+            if (logMoves)
+                fprintf(outputFile, "Change %d: Cost = %d, Penalty = %d\n", j, currentCost, currentPenalty);
+
+            if (currentCost < search->bestCost || (currentCost == search->bestCost && currentPenalty < search->bestPenalty))
+            {
+                search->bestCost = currentCost;
+                search->bestPenalty = currentPenalty;
+                if (search->bestXvalue != NULL)
+                {
+                    memcpy(search->bestXvalue, Xvalue, sizeof(int) * numberofvariables);
+                    search->published = 0;
+                }
+            }
+            if (search->elite != NULL && !search->published && (search->moves % ELITE_PERIOD == 0 || (currentCost == 0 && currentPenalty == 0)))
+            {
+                publishElite(search->elite, search->bestXvalue, search->bestCost, search->bestPenalty);
+                search->published = 1;
+            }
+
+            // The run counts as solved from its first assignment without conflicts, whatever it does after that
+            if (currentCost == 0 && search->solvedAt == 0.0)
+                search->solvedAt = wallClock();
+
+            // if A satisfies P then return (A)...with no conflicts the search goes on while there is a penalty,
+            // unless the first solution stops every run. A --target-cost is good enough whatever the penalty
+            if ((currentCost == 0 && (currentPenalty == 0 || params->stopAtSolution)) || currentCost <= params->targetCost)
+            {
+                if (stop != NULL && params->stopAtSolution)
+                    atomic_store(stop, 1); // The other runs stop now, not when this one is over
+                if (logTries)
+                {
+                    fprintf(outputFile, (currentCost == 0) ? "SOLUTION FOUND:\n" : "TARGET COST REACHED:\n");
+                    for (int k = 0; k < numberofvariables; k++)
+                    {
+                        fprintf(outputFile, "X%d = %d\n", k + 1, Xvalue[k]);
+                    }
+                }
+                freeConflictTable(table);
+                return 1; // Solution found
+            }
+
+            // Out of time...the best assignment so far is the result
+            if (params->deadline > 0.0 && (search->moves & (DEADLINE_CHECK - 1)) == 0 && wallClock() >= params->deadline)
+            {
+                if (logTries)
+                    fprintf(outputFile, "TIME LIMIT REACHED\n");
+                search->timedOut = 1;
+                freeConflictTable(table);
+                return 1;
+            }
+
+            //  x := randomly chosen variable whose assignment is in conflict
+            int x = RandomVariableConflict(numberofvariables, table, search->graph, &search->rng);
+
+            // (x,a) := the move of the strategy
+            int previous = Xvalue[x];
+            int newCost = currentCost;
+            int newPenalty = currentPenalty;
+            int value = strategy->chooseValue(search, x, &newCost, &newPenalty);
+            if (value != previous)
+            {
+                assignVariable(table, Xvalue, x, value, numberofvalues, search->graph);
+                if (strategy->moved != NULL)
+                    strategy->moved(search, x, previous);
+            }
+            if (logMoves)
+                fprintf(outputFile, "X%d changed from %d to %d (Cost = %d, Penalty = %d)\n", x, previous, value, table->cost, table->penalty);
+
+            if (trace != NULL)
+                traceMove(trace, i, j, x, value, table->cost);
+        }
+
+        // The try is over...its best assignment goes to the elite pool before the next one looks there
+        if (search->elite != NULL && !search->published)
+        {
+            publishElite(search->elite, search->bestXvalue, search->bestCost, search->bestPenalty);
+            search->published = 1;
+        }
+
+        // Print the assignment after all maxChanges
+        if (logTries)
+        {
+            fprintf(outputFile, "Assignment after maxChanges:\n");
+            for (int k = 0; k < numberofvariables; k++)
+            {
+                fprintf(outputFile, "X%d = %d\n", k, Xvalue[k]);
+            }
+        }
+        freeConflictTable(table);
+    }
+
+    if (logTries)
+        fprintf(outputFile, "NO SOLUTION FOUND AFTER %d TRIES.\n", params->maxTries);
+    return 1;
+}
+
+// minconflicts...the best alternative value, only if it does not make the cost (then the penalty) worse
+int chooseBestValue(SearchState *search, int x, int *newCost, int *newPenalty)
+{
+    int value = AlternativeAssignment(search->Xvalue, x, search->numberofvalues, &search->table, search->graph, newCost, newPenalty);
+
+    // if by making assignment (x,a) you get a cost ≤ current cost then make the assignment
+    if (*newCost < search->table.cost || (*newCost == search->table.cost && *newPenalty <= search->table.penalty))
+    {
+        return value;
+    }
+    *newCost = search->table.cost;
+    *newPenalty = search->table.penalty;
+    return search->Xvalue[x]; // Go to CurrentValue
+}
+
+// walk...with probability p a random value, otherwise the best alternative value
+int chooseWalkValue(SearchState *search, int x, int *newCost, int *newPenalty)
+{
+    int randomNumber = (int)rngBounded(&search->rng, 100) + 1; // Random number between 1 and 100
+    if (randomNumber <= (int)(search->params->p * 100)) // if probability p verified (e.g i give 10%...if randomNumber <= 10 then p is verified)
+    {
+        // (x,a) := randomly chosen alternative assignment of x
+        int value = (int)rngBounded(&search->rng, search->numberofvalues);
+        const int *soft = search->table.penalties + x * search->numberofvalues;
+        *newCost = search->table.cost + moveDelta(&search->table, search->Xvalue, x, value, search->numberofvalues, search->graph);
+        *newPenalty = search->table.penalty - soft[search->Xvalue[x]] + soft[value];
+        return value;
+    }
+    // (x,a) := the alternative assignment of x which satisfies the maximum number of constraints under the current assignment A
+    return AlternativeAssignment(search->Xvalue, x, search->numberofvalues, &search->table, search->graph, newCost, newPenalty);
+}
+
+// tabu...the best value that was not left recently, unless it beats the best cost of the run
+int startTabu(SearchState *search)
+{
+    TabuState *tabu = malloc(sizeof(TabuState));
+    if (tabu == NULL)
+    {
+        return 0;
+    }
+    tabu->expiry = malloc(sizeof(int) * search->numberofvariables * search->numberofvalues);
+    if (tabu->expiry == NULL)
+    {
+        free(tabu);
+        return 0;
+    }
+    search->data = tabu;
+    return 1;
+}
+
+void restartTabu(SearchState *search)
+{
+    TabuState *tabu = search->data;
+    memset(tabu->expiry, 0, sizeof(int) * search->numberofvariables * search->numberofvalues);
+    tabu->iteration = 0;
+    tabu->tenure = search->params->tabuSize;
+    tabu->bestCost = INT_MAX;
+    tabu->bestPenalty = INT_MAX;
+    tabu->stagnation = 0;
+}
+
+int chooseTabuValue(SearchState *search, int x, int *newCost, int *newPenalty)
+{
+    TabuState *tabu = search->data;
+    const int *row = moveRow(&search->table, search->Xvalue, x, search->numberofvalues, search->graph);
+    const int *soft = search->table.penalties + x * search->numberofvalues;
+    const int *expiry = tabu->expiry + x * search->numberofvalues;
+    int original = search->Xvalue[x];
+
+    // Tabu moves are allowed only if they beat the best (cost, penalty) of the run (aspiration),
+    // that is if their entries are below bestCost - cost + row[original] and bestPenalty - penalty + soft[original]
+    int threshold = search->bestCost - search->table.cost + row[original];
+    int thresholdSoft = search->bestPenalty - search->table.penalty + soft[original];
+    int lowest, lowestSoft;
+    int bestValue = rowArgminAllowed(row, soft, expiry, search->numberofvalues, original, tabu->iteration, threshold, thresholdSoft, &lowest, &lowestSoft);
+
+    *newCost = (lowest == INT_MAX) ? INT_MAX : search->table.cost - row[original] + lowest;
+    *newPenalty = (lowest == INT_MAX) ? INT_MAX : search->table.penalty - soft[original] + lowestSoft;
+    return bestValue;
+}
+
+// x may not go back to previous for the next tenure moves
+void movedTabu(SearchState *search, int x, int previous)
+{
+    TabuState *tabu = search->data;
+    int tenure = tabu->tenure;
+
+    if (search->params->tabuTenure == TENURE_DYNAMIC)
+    {
+        // Random part plus a part that grows with the number of conflicted variables
+        tenure = (int)rngBounded(&search->rng, search->params->tabuSize) + (int)(TABU_DYNAMIC_FACTOR * search->table.conflicted);
+    }
+    else if (search->params->tabuTenure == TENURE_REACTIVE)
+    {
+        // Longer while the search is stuck, back towards tabuSize once it improves
+        if (search->table.cost < tabu->bestCost || (search->table.cost == tabu->bestCost && search->table.penalty < tabu->bestPenalty))
+        {
+            tabu->bestCost = search->table.cost;
+            tabu->bestPenalty = search->table.penalty;
+            tabu->stagnation = 0;
+            tabu->tenure = (tabu->tenure * 9) / 10;
+            if (tabu->tenure < search->params->tabuSize)
+                tabu->tenure = search->params->tabuSize;
+        }
+        else if (++tabu->stagnation >= TABU_REACTIVE_WINDOW)
+        {
+            tabu->stagnation = 0;
+            tabu->tenure += tabu->tenure / 10 + 1;
+            if (tabu->tenure > search->numberofvariables)
+                tabu->tenure = search->numberofvariables;
+        }
+        tenure = tabu->tenure;
+    }
+
+    tabu->iteration++;
+    tabu->expiry[x * search->numberofvalues + previous] = tabu->iteration + tenure;
+}
+
+void finishTabu(SearchState *search)
+{
+    TabuState *tabu = search->data;
+    if (tabu != NULL)
+    {
+        free(tabu->expiry);
+        free(tabu);
+        search->data = NULL;
+    }
+}
+
+// anneal...a random value of x, kept if it is not worse, otherwise with probability exp(-delta / temperature)
+int startAnneal(SearchState *search)
+{
+    AnnealState *anneal = malloc(sizeof(AnnealState));
+    if (anneal == NULL)
+    {
+        return 0;
+    }
+    search->data = anneal;
+    return 1;
+}
+
+void restartAnneal(SearchState *search)
+{
+    AnnealState *anneal = search->data;
+    const SolverParams *params = search->params;
+    anneal->temperature = params->temperature;
+    anneal->coolingRate = params->coolingRate;
+    if (anneal->coolingRate <= 0.0)
+        anneal->coolingRate = (params->temperature > ANNEAL_FINAL) ? pow(ANNEAL_FINAL / params->temperature, 1.0 / params->maxChanges) : 1.0;
+    anneal->windowCooling = pow(anneal->coolingRate, ANNEAL_WINDOW);
+    anneal->proposed = 0;
+    anneal->accepted = 0;
+    anneal->bestCost = INT_MAX;
+    anneal->bestPenalty = INT_MAX;
+    anneal->stagnation = 0;
+}
+
+int chooseAnnealValue(SearchState *search, int x, int *newCost, int *newPenalty)
+{
+    AnnealState *anneal = search->data;
+    const SolverParams *params = search->params;
+    ConflictTable *table = &search->table;
+    int current = search->Xvalue[x];
+    if (search->numberofvalues < 2)
+        return current;
+
+    // (x,a) := random alternative assignment of x, scored from the tables in O(1)
+    int value = (int)rngBounded(&search->rng, search->numberofvalues - 1);
+    value += (value >= current);
+    const int *soft = table->penalties + x * search->numberofvalues;
+    int delta = moveDelta(table, search->Xvalue, x, value, search->numberofvalues, search->graph);
+    int softDelta = soft[value] - soft[current];
+
+    // Conflicts decide, the penalty only when the conflicts do not change
+    int worse = (delta != 0) ? delta : softDelta;
+    int accept = worse <= 0;
+    if (!accept && anneal->temperature > 0.0)
+    {
+        double draw = (rngNext(&search->rng) + 0.5) / 4294967296.0; // In (0, 1)
+        accept = draw < exp(-worse / anneal->temperature);
+    }
+
+    // Temperature for the next move
+    anneal->proposed++;
+    anneal->accepted += accept;
+    if (params->cooling == COOLING_ADAPTIVE)
+    {
+        if (anneal->proposed == ANNEAL_WINDOW)
+        {
+            int enough = anneal->accepted >= ANNEAL_ACCEPTANCE * ANNEAL_WINDOW;
+            anneal->temperature = enough ? anneal->temperature * anneal->windowCooling : anneal->temperature / anneal->windowCooling;
+            anneal->proposed = 0;
+            anneal->accepted = 0;
+        }
+    }
+    else
+    {
+        anneal->temperature *= anneal->coolingRate;
+    }
+    if (params->cooling == COOLING_REHEATING)
+    {
+        if (table->cost < anneal->bestCost || (table->cost == anneal->bestCost && table->penalty < anneal->bestPenalty))
+        {
+            anneal->bestCost = table->cost;
+            anneal->bestPenalty = table->penalty;
+            anneal->stagnation = 0;
+        }
+        else if (++anneal->stagnation >= ANNEAL_REHEAT_AFTER)
+        {
+            anneal->temperature = params->temperature;
+            anneal->stagnation = 0;
+        }
+    }
+
+    if (!accept)
+    {
+        return current;
+    }
+    *newCost = table->cost + delta;
+    *newPenalty = table->penalty + softDelta;
+    return value;
+}
+
+void finishAnneal(SearchState *search)
+{
+    free(search->data);
+    search->data = NULL;
+}
+
+// breakout...the best value under the weighted conflicts (conflicts plus guides), and where x has none that improves,
+// one more unit of weight on its violated constraints so that the plateau it sits on rises
+int startBreakout(SearchState *search)
+{
+    int edges = search->graph->offsets[search->numberofvariables];
+    BreakoutState *breakout = malloc(sizeof(BreakoutState));
+    if (breakout == NULL)
+    {
+        return 0;
+    }
+    breakout->bonus = malloc(sizeof(int) * (edges > 0 ? edges : 1));
+    breakout->guides = malloc(sizeof(int) * search->numberofvariables * search->numberofvalues);
+    breakout->combined = malloc(sizeof(int) * search->numberofvalues);
+    if (breakout->bonus == NULL || breakout->guides == NULL || breakout->combined == NULL)
+    {
+        free(breakout->bonus);
+        free(breakout->guides);
+        free(breakout->combined);
+        free(breakout);
+        return 0;
+    }
+    search->data = breakout;
+    return 1;
+}
+
+// Every try starts from the plain conflicts
+void restartBreakout(SearchState *search)
+{
+    BreakoutState *breakout = search->data;
+    int edges = search->graph->offsets[search->numberofvariables];
+    memset(breakout->bonus, 0, sizeof(int) * edges);
+    memset(breakout->guides, 0, sizeof(int) * search->numberofvariables * search->numberofvalues);
+    search->table.bonus = breakout->bonus;
+    search->table.guides = breakout->guides;
+}
+
+int chooseBreakoutValue(SearchState *search, int x, int *newCost, int *newPenalty)
+{
+    BreakoutState *breakout = search->data;
+    ConflictTable *table = &search->table;
+    int numberofvalues = search->numberofvalues;
+    const int *row = moveRow(table, search->Xvalue, x, numberofvalues, search->graph);
+    const int *guides = table->guides + x * numberofvalues;
+    const int *soft = table->penalties + x * numberofvalues;
+    int current = search->Xvalue[x];
+
+    for (int value = 0; value < numberofvalues; value++)
+    {
+        breakout->combined[value] = row[value] + guides[value];
+    }
+    int lowest, lowestSoft;
+    int value = rowArgmin(breakout->combined, soft, numberofvalues, current, &lowest, &lowestSoft);
+
+    // Every other value is worse under the weights...x is at a local minimum, its violated constraints get heavier
+    // and it stays. Sideways moves are made like in minconflicts
+    int here = breakout->combined[current];
+    if (lowest > here || (lowest == here && lowestSoft > soft[current]))
+    {
+        raiseWeights(table, search->Xvalue, x, numberofvalues, search->graph);
+        *newCost = table->cost;
+        *newPenalty = table->penalty;
+        return current;
+    }
+    *newCost = table->cost - row[current] + row[value];
+    *newPenalty = table->penalty - soft[current] + soft[value];
+    return value;
+}
+
+void finishBreakout(SearchState *search)
+{
+    BreakoutState *breakout = search->data;
+    if (breakout != NULL)
+    {
+        free(breakout->bonus);
+        free(breakout->guides);
+        free(breakout->combined);
+        free(breakout);
+        search->data = NULL;
+    }
+}